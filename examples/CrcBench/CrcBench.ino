@@ -0,0 +1,75 @@
+// Benchmark for the SD CRC functions selected by USE_SD_CRC.
+//
+// Set USE_SD_CRC in SdFatConfig.h to 1, 2, 3, or 4 and compare results.
+// With 4 the sketch's sdCrcCcitt() below is timed.  Replace it with a
+// hardware CRC unit to benchmark the hardware.
+#include "SdFat.h"
+#include "SdCard/SdSpiCard/SdCrc.h"
+
+#if USE_SD_CRC == 0
+#error "Set USE_SD_CRC nonzero in SdFatConfig.h"
+#endif  // USE_SD_CRC == 0
+
+#if USE_SD_CRC == 4
+// Application CRC-CCITT, the same shift based code as USE_SD_CRC 1.
+uint16_t sdCrcCcitt(const uint8_t* data, size_t n) {
+  uint16_t crc = 0;
+  for (size_t i = 0; i < n; i++) {
+    crc = (uint8_t)(crc >> 8) | (crc << 8);
+    crc ^= data[i];
+    crc ^= (uint8_t)(crc & 0xff) >> 4;
+    crc ^= crc << 12;
+    crc ^= (crc & 0xff) << 5;
+  }
+  return crc;
+}
+#endif  // USE_SD_CRC == 4
+
+// Number of 512 byte sectors to CRC.
+const uint16_t SECTOR_COUNT = 1000;
+
+uint8_t buf[512];
+//------------------------------------------------------------------------------
+void setup() {
+  Serial.begin(9600);
+  while (!Serial) {
+    yield();
+  }
+  Serial.print(F("USE_SD_CRC: "));
+  Serial.println(USE_SD_CRC);
+
+  // Check value for CRC-CCITT (XMODEM) of "123456789" is 0X31C3.
+  uint16_t check = sdCrcCcitt(reinterpret_cast<const uint8_t*>("123456789"), 9);
+  Serial.print(F("check: 0X"));
+  Serial.println(check, HEX);
+  if (check != 0X31C3) {
+    Serial.println(F("CRC error"));
+    return;
+  }
+  for (size_t i = 0; i < sizeof(buf); i++) {
+    buf[i] = i;
+  }
+  uint16_t crc = 0;
+  uint32_t m = micros();
+  for (uint16_t i = 0; i < SECTOR_COUNT; i++) {
+    buf[0] = i;
+    crc ^= sdCrcCcitt(buf, sizeof(buf));
+  }
+  m = micros() - m;
+  float bytes = 512.0 * SECTOR_COUNT;
+  Serial.print(F("crc: 0X"));
+  Serial.println(crc, HEX);
+  Serial.print(F("usec per sector: "));
+  Serial.println(static_cast<float>(m) / SECTOR_COUNT);
+  Serial.print(F("MB/sec: "));
+  Serial.println(bytes / m);
+#ifdef F_CPU
+  Serial.print(F("cycles per byte: "));
+  Serial.println(static_cast<float>(F_CPU) * m / 1e6 / bytes);
+  Serial.print(F("bytes per cycle: "));
+  Serial.println(bytes * 1e6 / (static_cast<float>(F_CPU) * m), 4);
+#endif  // F_CPU
+  Serial.println(F("Done"));
+}
+//------------------------------------------------------------------------------
+void loop() {}
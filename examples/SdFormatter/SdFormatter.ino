@@ -58,7 +58,13 @@ const uint8_t SD_CS_PIN = SDCARD_SS_PIN;
 ArduinoOutStream cout(Serial);
 //------------------------------------------------------------------------------
 uint32_t cardSectorCount = 0;
-uint8_t sectorBuffer[512] __attribute__ ((aligned (4)));
+// Larger buffers zero the FAT with fewer, longer writes.
+#if defined(RAMEND) && RAMEND < 3000
+const size_t BUFFER_SECTORS = 1;
+#else  // defined(RAMEND) && RAMEND < 3000
+const size_t BUFFER_SECTORS = 16;
+#endif  // defined(RAMEND) && RAMEND < 3000
+uint8_t sectorBuffer[512 * BUFFER_SECTORS] __attribute__ ((aligned (4)));
 //------------------------------------------------------------------------------
 // SdCardFactory constructs and initializes the appropriate card.
 SdCardFactory cardFactory;
@@ -135,8 +141,10 @@ void formatCard() {
 
   // Format exFAT if larger than 32GB.
   bool rtn = cardSectorCount > 67108864
-                 ? exFatFormatter.format(m_card, sectorBuffer, &Serial)
-                 : fatFormatter.format(m_card, sectorBuffer, &Serial);
+                 ? exFatFormatter.format(m_card, sectorBuffer, &Serial,
+                                         BUFFER_SECTORS)
+                 : fatFormatter.format(m_card, sectorBuffer, &Serial,
+                                       BUFFER_SECTORS);
 
   if (!rtn) {
     sdErrorHalt();
@@ -211,6 +211,9 @@ void loop() {
   cout << F("BUF_SIZE = ") << BUF_SIZE << F(" bytes\n");
   cout << F("Starting write test, please wait.") << endl << endl;
 
+#if SD_LATENCY_STATS
+  sd.card()->latencyStats()->clear();
+#endif  // SD_LATENCY_STATS
   // do write test
   uint32_t n = FILE_SIZE / BUF_SIZE;
   cout << F("write speed and latency") << endl;
@@ -305,6 +308,10 @@ void loop() {
     cout << s / t << ',' << maxLatency << ',' << minLatency;
     cout << ',' << totalLatency / n << endl;
   }
+#if SD_LATENCY_STATS
+  cout << endl << F("card command latency") << endl;
+  sd.card()->latencyStats()->printStats(&Serial);
+#endif  // SD_LATENCY_STATS
   cout << endl << F("Done") << endl;
   file.close();
   sd.end();
@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * Host check and benchmark for the SD CRC functions selected by USE_SD_CRC.
+ *
+ * sdCrc7() and sdCrcCcitt() are compared with bitwise reference functions
+ * for many lengths and buffer alignments, then sdCrcCcitt() is timed on
+ * 512 byte sectors.  The program exits with status one on a mismatch.
+ *
+ * Build once for each level on Linux, for example:
+ *
+ * for n in 1 2 3 4; do
+ *   g++ -O2 -DENABLE_ARDUINO_FEATURES=0 -DUSE_SD_CRC=$n -Isrc \
+ *     extras/CrcBench/CrcBench.cpp src/SdCard/SdSpiCard/SdCrc.cpp \
+ *     -o crcbench && ./crcbench
+ * done
+ *
+ * With USE_SD_CRC 4 the application CRC-CCITT below is the bitwise
+ * reference so only sdCrc7() is a real check.
+ *
+ * Options:
+ *   -f MHz    CPU clock for bytes per cycle.  The default on x86 is the
+ *             time stamp counter, which runs at the nominal clock.
+ *   -n count  Sectors to CRC for the benchmark, default 100000.
+ */
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAS_TSC 1
+#else  // defined(__x86_64__) || defined(__i386__)
+#define HAS_TSC 0
+#endif  // defined(__x86_64__) || defined(__i386__)
+
+#include "SdCard/SdSpiCard/SdCrc.h"
+
+#if USE_SD_CRC == 0
+#error "Build with USE_SD_CRC set to 1, 2, 3 or 4."
+#endif  // USE_SD_CRC == 0
+//------------------------------------------------------------------------------
+// Bitwise CRC7 with the x^7 + x^3 + 1 polynomial.
+static uint8_t refCrc7(const uint8_t* data, size_t n) {
+  uint8_t crc = 0;
+  for (size_t i = 0; i < n; i++) {
+    for (int j = 7; j >= 0; j--) {
+      uint8_t bit = ((data[i] >> j) ^ (crc >> 6)) & 1;
+      crc = (crc << 1) & 0X7F;
+      if (bit) {
+        crc ^= 0X09;
+      }
+    }
+  }
+  return (crc << 1) | 1;
+}
+//------------------------------------------------------------------------------
+// Bitwise CRC-CCITT with the x^16 + x^12 + x^5 + 1 polynomial.
+static uint16_t refCrcCcitt(const uint8_t* data, size_t n) {
+  uint16_t crc = 0;
+  for (size_t i = 0; i < n; i++) {
+    crc ^= static_cast<uint16_t>(data[i]) << 8;
+    for (int j = 0; j < 8; j++) {
+      crc = crc & 0X8000 ? (crc << 1) ^ 0X1021 : crc << 1;
+    }
+  }
+  return crc;
+}
+#if USE_SD_CRC == 4
+uint16_t sdCrcCcitt(const uint8_t* data, size_t n) {
+  return refCrcCcitt(data, n);
+}
+#endif  // USE_SD_CRC == 4
+//------------------------------------------------------------------------------
+int main(int argc, char* argv[]) {
+  uint32_t count = 100000;
+  double mhz = 0;
+  int c;
+  while ((c = getopt(argc, argv, "f:n:")) != -1) {
+    if (c == 'f') {
+      mhz = strtod(optarg, nullptr);
+    } else if (c == 'n') {
+      count = strtoul(optarg, nullptr, 0);
+    } else {
+      fprintf(stderr, "usage: %s [-f MHz] [-n count]\n", argv[0]);
+      return 1;
+    }
+  }
+  static uint8_t buf[2048 + 8];
+  uint32_t seed = 1;
+  for (size_t i = 0; i < sizeof(buf); i++) {
+    seed = seed * 1103515245 + 12345;
+    buf[i] = seed >> 16;
+  }
+  printf("USE_SD_CRC: %d\n", USE_SD_CRC);
+  const uint8_t* check = reinterpret_cast<const uint8_t*>("123456789");
+  if (sdCrcCcitt(check, 9) != 0X31C3) {
+    printf("error: CRC-CCITT check value\n");
+    return 1;
+  }
+  // Lengths include zero and odd tails.  Offsets test unaligned buffers.
+  for (size_t offset = 0; offset < 8; offset++) {
+    for (size_t n = 0; n <= 2048; n++) {
+      if (sdCrcCcitt(buf + offset, n) != refCrcCcitt(buf + offset, n)) {
+        printf("error: CRC-CCITT offset %zu length %zu\n", offset, n);
+        return 1;
+      }
+    }
+    for (uint8_t n = 0; n <= 32; n++) {
+      if (sdCrc7(buf + offset, n) != refCrc7(buf + offset, n)) {
+        printf("error: CRC7 offset %zu length %u\n", offset, n);
+        return 1;
+      }
+    }
+  }
+  printf("reference check: ok\n");
+
+  uint16_t crc = 0;
+#if HAS_TSC
+  uint64_t tsc = __rdtsc();
+#endif  // HAS_TSC
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < count; i++) {
+    buf[0] = i;
+    crc += sdCrcCcitt(buf, 512);
+  }
+  std::chrono::duration<double> t = std::chrono::steady_clock::now() - start;
+  double cycles = mhz * 1e6 * t.count();
+#if HAS_TSC
+  if (mhz == 0) {
+    cycles = __rdtsc() - tsc;
+  }
+#endif  // HAS_TSC
+  double bytes = 512.0 * count;
+  printf("crc: 0X%04X\n", crc);
+  printf("usec per sector: %.3f\n", 1e6 * t.count() / count);
+  printf("MB/sec: %.1f\n", 1e-6 * bytes / t.count());
+  if (cycles > 0) {
+    printf("bytes per cycle: %.3f\n", bytes / cycles);
+    printf("cycles per byte: %.3f\n", cycles / bytes);
+  } else {
+    printf("Use -f MHz for bytes per cycle.\n");
+  }
+  return 0;
+}
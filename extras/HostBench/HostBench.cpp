@@ -0,0 +1,322 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * Host benchmark for FatVolume, ExFatVolume and FsVolume.
+ *
+ * Volumes are formatted on a RamBlockDevice and each test reports
+ * operations per second plus the device commands and sectors it used.
+ *
+ * Build on Linux with -DENABLE_ARDUINO_FEATURES=0 -Isrc -Iextras/HostBench
+ * and the .cpp files in src/common, src/FatLib, src/ExFatLib and src/FsLib.
+ *
+ * Options:
+ *   -c count  Files for the create/open/list/remove tests, default 500.
+ *   -l usec   Latency added to every device command, default 0.
+ *   -m MiB    Size of the large read/write test file, default 64.
+ *   -s count  Device size in FS_SECTOR_SIZE sectors, default 4 GiB.
+ */
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <chrono>
+
+#include "RamBlockDevice.h"
+//------------------------------------------------------------------------------
+// Records for small read/write tests.
+const uint32_t SMALL_COUNT = 16384;
+const size_t SMALL_SIZE = 64;
+// Clusters in each of the two interleaved files for the seek test.
+const uint32_t FRAG_CLUSTERS = 1024;
+// Random seeks in the fragmented file.
+const uint32_t SEEK_COUNT = 2000;
+// Calls to freeClusterCount().
+const uint32_t FREE_COUNT = 10;
+// Files and size for preAllocate() and truncate() tests.
+const uint32_t ALLOC_COUNT = 16;
+const uint32_t ALLOC_SIZE = 16UL << 20;
+
+RamBlockDevice dev;
+Sector_t sectorCount = 0X800000 >> (FS_SECTOR_SIZE_SHIFT - 9);
+uint32_t latencyUs = 0;
+uint32_t fileCount = 500;
+uint32_t largeMiB = 64;
+uint8_t buf[1 << 16];
+//------------------------------------------------------------------------------
+class Timer {
+ public:
+  void start(const char* name) {
+    m_name = name;
+    dev.clearCounters();
+    m_start = std::chrono::steady_clock::now();
+  }
+  void stop(uint32_t ops, uint64_t bytes = 0) {
+    std::chrono::duration<double> t =
+        std::chrono::steady_clock::now() - m_start;
+    const RamBlockDevice::Counters& c = dev.counters();
+    double s = t.count() > 0 ? t.count() : 1e-9;
+    printf("%-12s %8" PRIu32 " %12.0f %9.1f %9" PRIu64 " %9" PRIu64
+           " %9" PRIu64 " %9" PRIu64 "\n",
+           m_name, ops, ops / s, bytes / s / 1e6, c.readCmds, c.readSectors,
+           c.writeCmds, c.writeSectors);
+  }
+
+ private:
+  const char* m_name;
+  std::chrono::steady_clock::time_point m_start;
+};
+//------------------------------------------------------------------------------
+#define error(msg)              \
+  do {                          \
+    printf("error: %s\n", msg); \
+    return false;               \
+  } while (0)
+//------------------------------------------------------------------------------
+template <class Vol, class File>
+bool writeCluster(Vol* vol, File* file) {
+  for (uint32_t n = 0; n < vol->bytesPerCluster(); n += sizeof(buf)) {
+    size_t m = vol->bytesPerCluster() - n;
+    m = m < sizeof(buf) ? m : sizeof(buf);
+    if (file->write(buf, m) != m) {
+      return false;
+    }
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+template <class Vol, class File>
+bool benchVolume(Vol* vol) {
+  Timer timer;
+  File file;
+  File dir;
+  File frag;
+  char name[32];
+  uint32_t n;
+
+  if (!vol->mkdir("bench")) {
+    error("mkdir");
+  }
+  timer.start("create");
+  for (uint32_t i = 0; i < fileCount; i++) {
+    snprintf(name, sizeof(name), "bench/file%05u.txt", i);
+    if (!file.open(vol, name, O_WRONLY | O_CREAT | O_EXCL)) {
+      error("create");
+    }
+    file.close();
+  }
+  timer.stop(fileCount);
+
+  timer.start("open");
+  for (uint32_t i = 0; i < fileCount; i++) {
+    snprintf(name, sizeof(name), "bench/file%05u.txt", i);
+    if (!file.open(vol, name, O_RDONLY)) {
+      error("open");
+    }
+    file.close();
+  }
+  timer.stop(fileCount);
+
+  timer.start("list");
+  if (!dir.open(vol, "bench", O_RDONLY)) {
+    error("open dir");
+  }
+  for (n = 0; file.openNext(&dir, O_RDONLY); n++) {
+    file.close();
+  }
+  dir.close();
+  timer.stop(n);
+
+  timer.start("remove");
+  for (uint32_t i = 0; i < fileCount; i++) {
+    snprintf(name, sizeof(name), "bench/file%05u.txt", i);
+    if (!vol->remove(name)) {
+      error("remove");
+    }
+  }
+  timer.stop(fileCount);
+
+  timer.start("write 64");
+  if (!file.open(vol, "small.bin", O_RDWR | O_CREAT | O_TRUNC)) {
+    error("open small");
+  }
+  for (uint32_t i = 0; i < SMALL_COUNT; i++) {
+    if (file.write(buf, SMALL_SIZE) != SMALL_SIZE) {
+      error("write small");
+    }
+  }
+  file.close();
+  timer.stop(SMALL_COUNT, SMALL_COUNT * SMALL_SIZE);
+
+  timer.start("read 64");
+  if (!file.open(vol, "small.bin", O_RDONLY)) {
+    error("open small");
+  }
+  for (uint32_t i = 0; i < SMALL_COUNT; i++) {
+    if (file.read(buf, SMALL_SIZE) != SMALL_SIZE) {
+      error("read small");
+    }
+  }
+  file.close();
+  timer.stop(SMALL_COUNT, SMALL_COUNT * SMALL_SIZE);
+
+  n = largeMiB << 4;
+  timer.start("write 64K");
+  if (!file.open(vol, "large.bin", O_RDWR | O_CREAT | O_TRUNC)) {
+    error("open large");
+  }
+  for (uint32_t i = 0; i < n; i++) {
+    if (file.write(buf, sizeof(buf)) != sizeof(buf)) {
+      error("write large");
+    }
+  }
+  file.close();
+  timer.stop(n, static_cast<uint64_t>(n) * sizeof(buf));
+
+  timer.start("read 64K");
+  if (!file.open(vol, "large.bin", O_RDONLY)) {
+    error("open large");
+  }
+  for (uint32_t i = 0; i < n; i++) {
+    if (file.read(buf, sizeof(buf)) != sizeof(buf)) {
+      error("read large");
+    }
+  }
+  file.close();
+  timer.stop(n, static_cast<uint64_t>(n) * sizeof(buf));
+
+  // Interleave clusters of two files so each file is fragmented.
+  if (!file.open(vol, "frag0.bin", O_RDWR | O_CREAT | O_TRUNC) ||
+      !frag.open(vol, "frag1.bin", O_RDWR | O_CREAT | O_TRUNC)) {
+    error("open frag");
+  }
+  for (uint32_t i = 0; i < FRAG_CLUSTERS; i++) {
+    if (!writeCluster(vol, &file) || !writeCluster(vol, &frag)) {
+      error("write frag");
+    }
+  }
+  frag.close();
+  timer.start("seek frag");
+  unsigned int seed = 1;
+  for (uint32_t i = 0; i < SEEK_COUNT; i++) {
+    uint32_t pos = rand_r(&seed) % file.fileSize();
+    if (!file.seekSet(pos) || file.read(buf, 1) != 1) {
+      error("seek frag");
+    }
+  }
+  file.close();
+  timer.stop(SEEK_COUNT);
+
+  timer.start("free count");
+  for (uint32_t i = 0; i < FREE_COUNT; i++) {
+    if (static_cast<int32_t>(vol->freeClusterCount()) < 0) {
+      error("freeClusterCount");
+    }
+  }
+  timer.stop(FREE_COUNT);
+
+  timer.start("preAllocate");
+  for (uint32_t i = 0; i < ALLOC_COUNT; i++) {
+    snprintf(name, sizeof(name), "alloc%02u.bin", i);
+    if (!file.open(vol, name, O_RDWR | O_CREAT | O_TRUNC) ||
+        !file.preAllocate(ALLOC_SIZE) || !file.close()) {
+      error("preAllocate");
+    }
+  }
+  timer.stop(ALLOC_COUNT);
+
+  timer.start("truncate");
+  for (uint32_t i = 0; i < ALLOC_COUNT; i++) {
+    snprintf(name, sizeof(name), "alloc%02u.bin", i);
+    if (!file.open(vol, name, O_RDWR) || !file.truncate(0) ||
+        !file.close()) {
+      error("truncate");
+    }
+  }
+  timer.stop(ALLOC_COUNT);
+  return true;
+}
+//------------------------------------------------------------------------------
+bool format(bool exFat) {
+  uint8_t secBuf[FS_SECTOR_SIZE];
+  if (!dev.begin(sectorCount, latencyUs)) {
+    error("device");
+  }
+  if (exFat) {
+    ExFatFormatter fmt;
+    return fmt.format(&dev, secBuf);
+  }
+  FatFormatter fmt;
+  return fmt.format(&dev, secBuf);
+}
+//------------------------------------------------------------------------------
+template <class Vol, class File>
+bool runBench(const char* volName, bool exFat) {
+  Vol vol;
+  if (!format(exFat)) {
+    error("format");
+  }
+  if (!vol.begin(&dev)) {
+    error("begin");
+  }
+  printf("\n%s %s, %u byte clusters, latency %u us\n", volName,
+         exFat ? "exFAT" : "FAT", (unsigned)vol.bytesPerCluster(), latencyUs);
+  printf("%-12s %8s %12s %9s %9s %9s %9s %9s\n", "test", "ops", "ops/s",
+         "MB/s", "rd cmds", "rd sect", "wr cmds", "wr sect");
+  return benchVolume<Vol, File>(&vol);
+}
+//------------------------------------------------------------------------------
+int main(int argc, char* argv[]) {
+  int c;
+  while ((c = getopt(argc, argv, "c:l:m:s:")) != -1) {
+    switch (c) {
+      case 'c':
+        fileCount = strtoul(optarg, nullptr, 0);
+        break;
+      case 'l':
+        latencyUs = strtoul(optarg, nullptr, 0);
+        break;
+      case 'm':
+        largeMiB = strtoul(optarg, nullptr, 0);
+        break;
+      case 's':
+        sectorCount = strtoul(optarg, nullptr, 0);
+        break;
+      default:
+        printf("usage: %s [-c files] [-l usec] [-m MiB] [-s sectors]\n",
+               argv[0]);
+        return 1;
+    }
+  }
+  for (uint32_t i = 0; i < sizeof(buf); i++) {
+    buf[i] = i;
+  }
+  bool ok = runBench<FatVolume, FatFile>("FatVolume", false) &&
+            runBench<ExFatVolume, ExFatFile>("ExFatVolume", true) &&
+            runBench<FsVolume, FsFile>("FsVolume", false) &&
+            runBench<FsVolume, FsFile>("FsVolume", true);
+  dev.end();
+  return ok ? 0 : 1;
+}
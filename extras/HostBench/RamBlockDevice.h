@@ -0,0 +1,127 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+/**
+ * \file
+ * \brief RAM block device with command counters for host benchmarks.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+
+#include "SdFat.h"
+/**
+ * \class RamBlockDevice
+ * \brief Block device in host RAM with optional per-command latency.
+ */
+class RamBlockDevice : public FsBlockDeviceInterface {
+ public:
+  /** Device counters. */
+  struct Counters {
+    /** Read commands. */
+    uint64_t readCmds;
+    /** Sectors read. */
+    uint64_t readSectors;
+    /** Write commands. */
+    uint64_t writeCmds;
+    /** Sectors written. */
+    uint64_t writeSectors;
+  };
+  ~RamBlockDevice() { end(); }
+  /** Allocate zeroed storage.
+   *
+   * \param[in] sectorCount Device size in sectors.
+   * \param[in] latencyUs Busy wait added to every read or write command.
+   * \return true for success or false for failure.
+   */
+  bool begin(Sector_t sectorCount, uint32_t latencyUs = 0) {
+    end();
+    // calloc() of a large block maps zero pages on demand.
+    m_data = static_cast<uint8_t*>(calloc(sectorCount, FS_SECTOR_SIZE));
+    m_sectorCount = m_data ? sectorCount : 0;
+    m_latencyUs = latencyUs;
+    clearCounters();
+    return m_data != nullptr;
+  }
+  /** Clear the command and sector counters. */
+  void clearCounters() { memset(&m_counters, 0, sizeof(m_counters)); }
+  /** \return Device counters. */
+  const Counters& counters() const { return m_counters; }
+  /** Free storage. */
+  void end() override {
+    free(m_data);
+    m_data = nullptr;
+    m_sectorCount = 0;
+  }
+  bool isBusy() override { return false; }
+  bool readSector(Sector_t sector, uint8_t* dst) override {
+    return readSectors(sector, dst, 1);
+  }
+  bool readSectors(Sector_t sector, uint8_t* dst, size_t ns) override {
+    m_counters.readCmds++;
+    m_counters.readSectors += ns;
+    delay();
+    if (!validRange(sector, ns)) {
+      return false;
+    }
+    memcpy(dst, m_data + FS_SECTOR_SIZE * size_t(sector), FS_SECTOR_SIZE * ns);
+    return true;
+  }
+  Sector_t sectorCount() override { return m_sectorCount; }
+  bool syncDevice() override { return true; }
+  bool writeSector(Sector_t sector, const uint8_t* src) override {
+    return writeSectors(sector, src, 1);
+  }
+  bool writeSectors(Sector_t sector, const uint8_t* src, size_t ns) override {
+    m_counters.writeCmds++;
+    m_counters.writeSectors += ns;
+    delay();
+    if (!validRange(sector, ns)) {
+      return false;
+    }
+    memcpy(m_data + FS_SECTOR_SIZE * size_t(sector), src, FS_SECTOR_SIZE * ns);
+    return true;
+  }
+
+ private:
+  void delay() {
+    if (m_latencyUs) {
+      // Busy wait since sleep granularity is too coarse.
+      auto end = std::chrono::steady_clock::now() +
+                 std::chrono::microseconds(m_latencyUs);
+      while (std::chrono::steady_clock::now() < end) {
+      }
+    }
+  }
+  bool validRange(Sector_t sector, size_t ns) const {
+    return sector < m_sectorCount && ns <= (m_sectorCount - sector);
+  }
+
+  Counters m_counters;
+  uint8_t* m_data = nullptr;
+  Sector_t m_sectorCount = 0;
+  uint32_t m_latencyUs = 0;
+};
@@ -0,0 +1,254 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * Replay and summarize an FsTraceDevice trace on a Linux host.
+ *
+ * A trace file is the log range written by FsTraceDevice::setLogDevice(),
+ * copied from the log device.  Records with op FS_TRACE_NONE are skipped.
+ * If the log range wrapped, replay starts with the oldest sector of
+ * records, found by the first backward step in record time.
+ *
+ * Usage: TraceReplay [-n] [-w] trace image
+ *   -n  Summarize only, do not replay.
+ *   -w  Replay writes.  Each write reads the current sectors and writes
+ *       them back so the image is not changed.
+ *
+ * The image is mounted to find the FAT and data regions.  Sectors
+ * below the data region are counted as metadata.  A read of a FAT
+ * sector that was read before, with other FAT reads between, is
+ * counted as a FAT re-read.
+ *
+ * Build on Linux with -DENABLE_ARDUINO_FEATURES=0 -Isrc and the .cpp
+ * files in src/common, src/FatLib, src/ExFatLib and src/FsLib.
+ */
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "SdFat.h"
+//------------------------------------------------------------------------------
+// Sectors replayed per device command.  Larger records are split.
+const size_t MAX_SECTORS = 256;
+
+FsImageDevice dev;
+std::vector<FsTraceRecord> trace;
+//------------------------------------------------------------------------------
+struct OpStats {
+  uint64_t cmds;
+  uint64_t sectors;
+  uint64_t sequential;
+  uint64_t metaCmds;
+  uint64_t fatCmds;
+  uint64_t failed;
+  uint64_t traceUs;
+  uint32_t maxUs;
+  uint32_t maxIndex;
+  double replaySec;
+  Sector_t next;
+};
+OpStats stats[4];
+//------------------------------------------------------------------------------
+bool loadTrace(const char* path) {
+  FsTraceRecord buf[FS_TRACE_PER_SECTOR];
+  // Index in trace of the first record of each sector.
+  std::vector<size_t> first;
+  FILE* file = fopen(path, "rb");
+  if (!file) {
+    return false;
+  }
+  while (fread(buf, sizeof(FsTraceRecord), FS_TRACE_PER_SECTOR, file) ==
+         FS_TRACE_PER_SECTOR) {
+    size_t n = trace.size();
+    for (size_t i = 0; i < FS_TRACE_PER_SECTOR; i++) {
+      if (buf[i].op != FS_TRACE_NONE && buf[i].op <= FS_TRACE_SYNC) {
+        trace.push_back(buf[i]);
+      }
+    }
+    if (trace.size() > n) {
+      first.push_back(n);
+    }
+  }
+  fclose(file);
+  // A wrapped log starts at the sector that steps back in time.
+  for (size_t k = 1; k < first.size(); k++) {
+    int32_t step = trace[first[k]].time - trace[first[k] - 1].time;
+    if (step < 0) {
+      std::rotate(trace.begin(), trace.begin() + first[k], trace.end());
+      break;
+    }
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+// Replay a record and add the time of the replayed command to sec.
+bool replay(const FsTraceRecord& r, uint8_t* buf, bool writes, double* sec) {
+  auto t0 = std::chrono::steady_clock::now();
+  bool rtn = true;
+  if (r.op == FS_TRACE_SYNC) {
+    rtn = dev.syncDevice();
+  } else if (r.op == FS_TRACE_READ) {
+    for (size_t i = 0; rtn && i < r.count; i += MAX_SECTORS) {
+      size_t ns = std::min(MAX_SECTORS, r.count - i);
+      rtn = dev.readSectors(r.sector + i, buf, ns);
+    }
+  } else if (writes) {
+    for (size_t i = 0; rtn && i < r.count; i += MAX_SECTORS) {
+      size_t ns = std::min(MAX_SECTORS, r.count - i);
+      // Write the current data back, the read is not timed.
+      auto t1 = std::chrono::steady_clock::now();
+      rtn = dev.readSectors(r.sector + i, buf, ns);
+      t0 += std::chrono::steady_clock::now() - t1;
+      rtn = rtn && dev.writeSectors(r.sector + i, buf, ns);
+    }
+  }
+  std::chrono::duration<double> t = std::chrono::steady_clock::now() - t0;
+  *sec += t.count();
+  return rtn;
+}
+//------------------------------------------------------------------------------
+int main(int argc, char* argv[]) {
+  const char* opName[] = {"", "read", "write", "sync"};
+  bool doReplay = true;
+  bool writes = false;
+  Sector_t fatStart = 0;
+  Sector_t fatEnd = 0;
+  Sector_t dataStart = 0;
+  uint64_t fatRereads = 0;
+  Sector_t lastFat = 0XFFFFFFFF;
+  std::vector<bool> fatSeen;
+  int c;
+
+  while ((c = getopt(argc, argv, "nw")) != -1) {
+    switch (c) {
+      case 'n':
+        doReplay = false;
+        break;
+      case 'w':
+        writes = true;
+        break;
+      default:
+        optind = argc;
+        break;
+    }
+  }
+  if ((argc - optind) != 2) {
+    printf("usage: %s [-n] [-w] trace image\n", argv[0]);
+    return 1;
+  }
+  if (!loadTrace(argv[optind])) {
+    printf("error: open %s\n", argv[optind]);
+    return 1;
+  }
+  uint8_t options = writes ? 0 : FsImageDevice::IMAGE_OPT_READ_ONLY;
+  if (!dev.begin(argv[optind + 1], options)) {
+    printf("error: open %s\n", argv[optind + 1]);
+    return 1;
+  }
+  FatVolume fatVol;
+  ExFatVolume exFatVol;
+  if (fatVol.begin(&dev, false)) {
+    fatStart = fatVol.fatStartSector();
+    fatEnd = fatStart + fatVol.fatCount() * fatVol.sectorsPerFat();
+    dataStart = fatVol.dataStartSector();
+  } else if (exFatVol.begin(&dev, false)) {
+    fatStart = exFatVol.fatStartSector();
+    fatEnd = fatStart + exFatVol.fatLength();
+    dataStart = exFatVol.clusterHeapStartSector();
+  }
+  if (dataStart) {
+    fatSeen.resize(fatEnd - fatStart);
+    printf("FAT sectors %" PRIu32 " to %" PRIu32 ", data at %" PRIu32 "\n",
+           fatStart, fatEnd - 1, dataStart);
+  } else {
+    printf("No volume, all sectors counted as data.\n");
+  }
+  std::vector<uint8_t> buf(FS_SECTOR_SIZE * MAX_SECTORS);
+  for (size_t i = 0; i < trace.size(); i++) {
+    const FsTraceRecord& r = trace[i];
+    OpStats* s = &stats[r.op];
+    s->cmds++;
+    s->sectors += r.count;
+    s->traceUs += r.duration;
+    if (r.duration > s->maxUs || s->cmds == 1) {
+      s->maxUs = r.duration;
+      s->maxIndex = i;
+    }
+    if (!r.status) {
+      s->failed++;
+    }
+    if (r.op != FS_TRACE_SYNC) {
+      if (r.sector == s->next) {
+        s->sequential++;
+      }
+      s->next = r.sector + r.count;
+      if (r.sector < dataStart) {
+        s->metaCmds++;
+      }
+      if (fatStart <= r.sector && r.sector < fatEnd) {
+        s->fatCmds++;
+        // A FAT sector read again after other FAT sectors is thrash.
+        if (r.op == FS_TRACE_READ) {
+          if (r.sector != lastFat && fatSeen[r.sector - fatStart]) {
+            fatRereads++;
+          }
+          fatSeen[r.sector - fatStart] = true;
+          lastFat = r.sector;
+        }
+      }
+    }
+    if (doReplay && !replay(r, buf.data(), writes, &s->replaySec) &&
+        r.status) {
+      printf("error: record %zu\n", i);
+      return 1;
+    }
+  }
+  printf("%zu records\n", trace.size());
+  printf("%-6s %9s %10s %6s %6s %6s %7s %10s %9s %11s\n", "op", "cmds",
+         "sectors", "seq%", "meta%", "FAT%", "failed", "trace ms", "max us",
+         "replay ms");
+  for (int op = FS_TRACE_READ; op <= FS_TRACE_SYNC; op++) {
+    OpStats* s = &stats[op];
+    double n = s->cmds ? s->cmds : 1;
+    printf("%-6s %9" PRIu64 " %10" PRIu64 " %6.1f %6.1f %6.1f %7" PRIu64
+           " %10.1f %9" PRIu32 " %11.1f\n",
+           opName[op], s->cmds, s->sectors, 100 * s->sequential / n,
+           100 * s->metaCmds / n, 100 * s->fatCmds / n, s->failed,
+           s->traceUs / 1e3, s->maxUs, s->replaySec * 1e3);
+    if (s->cmds) {
+      const FsTraceRecord& r = trace[s->maxIndex];
+      printf("       max at record %" PRIu32 ", sector %" PRIu32
+             ", count %u\n",
+             s->maxIndex, r.sector, r.count);
+    }
+  }
+  printf("FAT sector re-reads: %" PRIu64 "\n", fatRereads);
+  dev.end();
+  return 0;
+}
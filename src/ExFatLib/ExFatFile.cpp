@@ -203,7 +203,17 @@ bool ExFatFile::open(ExFatFile* dirFile, const char* path, oflag_t oflag) {
       path++;
     }
     if (*path == 0) {
-      return openRoot(dirFile->m_vol);
+      // Same access rules as a subdirectory.
+      oflag_t mode = oflag & (O_ACCMODE | O_TRUNC | O_APPEND | O_AT_END);
+      if ((mode != O_RDONLY && mode != O_RDWR) ||
+          !openRoot(dirFile->m_vol)) {
+        DBG_FAIL_MACRO;
+        goto fail;
+      }
+      if ((oflag & O_ACCMODE) == O_RDWR && !EXFAT_READ_ONLY) {
+        m_flags |= FILE_FLAG_WRITE;
+      }
+      return true;
     }
     if (!tmpDir.openRoot(dirFile->m_vol)) {
       DBG_FAIL_MACRO;
@@ -262,6 +272,24 @@ fail:
   return false;
 }
 //------------------------------------------------------------------------------
+bool ExFatFile::openCluster(ExFatVolume* vol, Cluster_t cluster,
+                            uint32_t length, bool isContiguous) {
+  if (cluster == 0) {
+    return openRoot(vol);
+  }
+  memset(this, 0, sizeof(ExFatFile));
+  m_attributes = FILE_ATTR_SUBDIR;
+  m_flags = FILE_FLAG_READ;
+  if (isContiguous) {
+    m_flags |= FILE_FLAG_CONTIGUOUS;
+  }
+  m_vol = vol;
+  m_firstCluster = cluster;
+  m_dataLength = length;
+  m_validLength = length;
+  return true;
+}
+//------------------------------------------------------------------------------
 bool ExFatFile::openNext(ExFatFile* dir, oflag_t oflag) {
   if (isOpen() || !dir->isDir() || (dir->curPosition() & 0X1F)) {
     DBG_FAIL_MACRO;
@@ -309,6 +337,7 @@ bool ExFatFile::openPrivate(ExFatFile* dir, ExName_t* fname, oflag_t oflag) {
   modeFlags |= (oflag & O_APPEND) ? FILE_FLAG_APPEND : 0;
 
   if (fname) {
+    FS_STATS_ADD(&dir->m_vol->m_stats, dirScans, 1);
     freeNeed = 2 + (fname->nameLength + 14) / 15;
     dir->rewind();
   }
@@ -396,9 +425,12 @@ found:
     DBG_FAIL_MACRO;
     goto fail;
   }
-  // Write, truncate, or at end is an error for a directory or read-only file.
+  // Write, truncate, or at end is an error for a read-only file.  A
+  // directory may only be opened O_RDWR, for compact().
   if ((oflag & (O_TRUNC | O_AT_END)) || (m_flags & FILE_FLAG_WRITE)) {
-    if (isSubDir() || isReadOnly() || EXFAT_READ_ONLY) {
+    if ((isSubDir() &&
+         (oflag & (O_ACCMODE | O_TRUNC | O_APPEND | O_AT_END)) != O_RDWR) ||
+        isReadOnly() || EXFAT_READ_ONLY) {
       DBG_FAIL_MACRO;
       goto fail;
     }
@@ -422,6 +454,10 @@ found:
     m_attributes |= FS_ATTRIB_ARCHIVE;
   }
 #endif  // !EXFAT_READ_ONLY
+#if USE_FS_FILE_STATS
+  // Do not charge the open to the file.
+  m_stats.clear();
+#endif  // USE_FS_FILE_STATS
   return true;
 
 create:
@@ -510,7 +546,15 @@ create:
       }
     }
   }
-  return sync();
+  if (!sync()) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+#if USE_FS_FILE_STATS
+  // Do not charge the open to the file.
+  m_stats.clear();
+#endif  // USE_FS_FILE_STATS
+  return true;
 #endif  // EXFAT_READ_ONLY
 
 fail:
@@ -574,6 +618,7 @@ int ExFatFile::peek() {
 }
 //------------------------------------------------------------------------------
 int ExFatFile::read(void* buf, size_t count) {
+  FS_FILE_STATS_SCOPE(isOpen() ? &m_vol->m_stats : nullptr);
   uint8_t* dst = reinterpret_cast<uint8_t*>(buf);
   int8_t fg;
   uint64_t maxRead;
@@ -675,6 +720,10 @@ int ExFatFile::read(void* buf, size_t count) {
     seekCur(toFill);
     rtn += toFill;
   }
+  if (isFile()) {
+    FS_STATS_ADD(&m_vol->m_stats, fileReads, 1);
+    FS_STATS_ADD(&m_vol->m_stats, fileReadBytes, rtn);
+  }
   return rtn;
 
 fail:
@@ -748,3 +797,66 @@ fail:
   m_curCluster = tmp;
   return false;
 }
+//------------------------------------------------------------------------------
+bool ExFatFile::walk(ExFatWalkCallback_t callback, void* context) {
+  // Directory to resume after a subdirectory is done.
+  struct {
+    Cluster_t cluster;
+    Cluster_t curCluster;
+    uint32_t length;
+    uint32_t position;
+    bool isContiguous;
+  } stack[WALK_MAX_DEPTH];
+  uint8_t depth = 0;
+  ExFatFile dir;
+  ExFatFile file;
+  if (!isDir()) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  dir.copy(this);
+  dir.rewind();
+  while (1) {
+    if (!file.openNext(&dir, O_RDONLY)) {
+      if (dir.getError()) {
+        DBG_FAIL_MACRO;
+        goto fail;
+      }
+      if (depth == 0) {
+        break;
+      }
+      depth--;
+      dir.close();
+      if (!dir.openCluster(m_vol, stack[depth].cluster, stack[depth].length,
+                           stack[depth].isContiguous)) {
+        DBG_FAIL_MACRO;
+        goto fail;
+      }
+      // Resume without following the cluster chain from the start.
+      dir.m_curCluster = stack[depth].curCluster;
+      dir.m_curPosition = stack[depth].position;
+      continue;
+    }
+    uint8_t rtn = callback(&file, depth, context);
+    if (rtn == WALK_STOP) {
+      file.close();
+      break;
+    }
+    // Do not descend below WALK_MAX_DEPTH, same as WALK_SKIP.
+    if (rtn != WALK_SKIP && file.isSubDir() && depth < WALK_MAX_DEPTH) {
+      stack[depth].cluster = dir.m_firstCluster;
+      stack[depth].curCluster = dir.m_curCluster;
+      stack[depth].length = dir.m_dataLength;
+      stack[depth].position = dir.m_curPosition;
+      stack[depth].isContiguous = dir.isContiguous();
+      depth++;
+      dir.copy(&file);
+      dir.rewind();
+    }
+    file.close();
+  }
+  return true;
+
+fail:
+  return false;
+}
@@ -53,6 +53,11 @@ class ExName_t : public FsName {
   uint16_t nameHash;
 };
 //------------------------------------------------------------------------------
+class ExFatFile;
+/** Callback for ExFatFile::walk(). */
+typedef uint8_t (*ExFatWalkCallback_t)(ExFatFile* file, uint8_t depth,
+                                       void* context);
+//------------------------------------------------------------------------------
 /**
  * \class ExFatFile
  * \brief Basic file class.
@@ -188,6 +193,21 @@ class ExFatFile {
    * \return true for success or false for failure.
    */
   bool close();
+  /** Compact a directory.
+   *
+   * Live directory entries are moved to the start of the directory,
+   * the remaining entries are marked free, and clusters that no longer
+   * contain live entries are freed.  This shortens directory scans after
+   * many files have been removed.
+   *
+   * The directory must be opened with O_RDWR.
+   *
+   * \note Files and subdirectories in the directory must be closed since
+   * their directory entries may be moved.
+   *
+   * \return true for success or false for failure.
+   */
+  bool compact();
   /** Check for contiguous file and return its raw sector range.
    *
    * \param[out] bgnSector the first sector address for the file.
@@ -512,9 +532,12 @@ class ExFatFile {
    * will equal the requested length.
    *
    * \param[in] length size of allocated space in bytes.
+   * \param[in] alignAu Start the file at an allocation unit boundary
+   * of the card if free space is available.  Streaming writes to whole
+   * allocation units are faster on most cards.
    * \return true for success or false for failure.
    */
-  bool preAllocate(uint64_t length);
+  bool preAllocate(uint64_t length, bool alignAu = false);
   /** Print a file's access date and time
    *
    * \param[in] pr Print stream for output.
@@ -725,6 +748,14 @@ class ExFatFile {
   bool seekSet(uint64_t pos);
   /** \return directory set count */
   uint8_t setCount() const { return m_setCount; }
+#if USE_FS_FILE_STATS
+  /** Set the operation counters for this file to zero. */
+  void clearStats() { m_stats.clear(); }
+  /** \return A snapshot of the volume counts caused by read(), write()
+   * and sync() calls since this file was opened or clearStats() was called.
+   */
+  FsStats stats() const { return m_stats; }
+#endif  // USE_FS_FILE_STATS
   /** The sync() call causes all modified data and directory fields
    * to be written to the storage device.
    *
@@ -787,6 +818,29 @@ class ExFatFile {
 
   /** \return The valid number of bytes in a file. */
   uint64_t validLength() const { return m_validLength; }
+  /** Walk the tree below this directory.
+   *
+   * Entries are visited in directory order and a subdirectory is visited
+   * before its contents.  The walk is iterative and streams through each
+   * directory once.  Ancestors are saved in a stack of WALK_MAX_DEPTH
+   * frames so no path lookups are done.  Each entry is opened from the
+   * cached directory sector and a parent resumes at its saved cluster.
+   *
+   * \param[in] callback Called for each entry with the open entry, the
+   * depth of the entry below this directory, and \a context.  The callback
+   * returns WALK_CONTINUE, WALK_SKIP to not descend into a subdirectory,
+   * or WALK_STOP to end the walk.
+   * \param[in] context Passed to \a callback.
+   *
+   * \note The entry is closed when the callback returns.  Files must not
+   * be created or removed during the walk.
+   *
+   * A subdirectory at depth WALK_MAX_DEPTH is passed to \a callback but
+   * its contents are not visited, as if \a callback returned WALK_SKIP.
+   *
+   * \return true for success or false for failure.
+   */
+  bool walk(ExFatWalkCallback_t callback, void* context = nullptr);
   /** Write a string to a file. Used by the Arduino Print class.
    * \param[in] str Pointer to the string.
    * Use getWriteError to check for errors.
@@ -842,9 +896,11 @@ class ExFatFile {
   uint8_t* dirCache(uint8_t set, uint8_t options);
   bool hashName(ExName_t* fname);
   bool mkdir(ExFatFile* parent, ExName_t* fname);
-
+  bool openCluster(ExFatVolume* vol, Cluster_t cluster, uint32_t length,
+                   bool isContiguous);
   bool openPrivate(ExFatFile* dir, ExName_t* fname, oflag_t oflag);
   bool parsePathName(const char* path, ExName_t* fname, const char** ptr);
+  uint32_t preEraseCount();
   ExFatVolume* volume() const { return m_vol; }
   bool syncDir();
   //----------------------------------------------------------------------------
@@ -879,6 +935,9 @@ class ExFatFile {
   uint8_t m_attributes = FILE_ATTR_CLOSED;
   uint8_t m_error = 0;
   uint8_t m_flags = 0;
+#if USE_FS_FILE_STATS
+  FsStats m_stats = {};
+#endif  // USE_FS_FILE_STATS
 };
 #include "../common/ArduinoFiles.h"
 /**
@@ -28,14 +28,16 @@
 #include "ExFatLib.h"
 //==============================================================================
 #if EXFAT_READ_ONLY
+bool ExFatFile::compact() { return false; }
 bool ExFatFile::mkdir(ExFatFile* parent, const char* path, bool pFlag) {
   (void)parent;
   (void)path;
   (void)pFlag;
   return false;
 }
-bool ExFatFile::preAllocate(uint64_t length) {
+bool ExFatFile::preAllocate(uint64_t length, bool alignAu) {
   (void)length;
+  (void)alignAu;
   return false;
 }
 bool ExFatFile::rename(const char* newPath) {
@@ -144,6 +146,114 @@ bool ExFatFile::addDirCluster() {
   }
   return sync();
 
+fail:
+  return false;
+}
+//------------------------------------------------------------------------------
+bool ExFatFile::compact() {
+  int n;
+  int8_t fg;
+  uint8_t* cache;
+  uint8_t buf[FS_DIR_SIZE];
+  DirPos_t dst;
+  Cluster_t toFree = 0;
+  uint32_t keep;
+  uint32_t nc;
+  uint32_t nk;
+  uint32_t zeroEnd;
+
+  if (!isDir() || !isWritable()) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  rewind();
+  dst.cluster = isRoot() ? m_vol->rootDirectoryCluster() : m_firstCluster;
+  dst.position = 0;
+  dst.isContiguous = isContiguous();
+  // Move entry sets down over unused entries.
+  while (1) {
+    n = read(buf, FS_DIR_SIZE);
+    if (n == 0) {
+      break;
+    }
+    if (n != FS_DIR_SIZE) {
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+    if (buf[0] == EXFAT_TYPE_END_DIR) {
+      break;
+    }
+    if (!(buf[0] & EXFAT_TYPE_USED)) {
+      continue;
+    }
+    if ((dst.position + FS_DIR_SIZE) != m_curPosition) {
+      cache = m_vol->dirCache(&dst, FsCache::CACHE_FOR_WRITE);
+      if (!cache) {
+        DBG_FAIL_MACRO;
+        goto fail;
+      }
+      memcpy(cache, buf, FS_DIR_SIZE);
+    }
+    if (m_vol->dirSeek(&dst, FS_DIR_SIZE) < 0) {
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+  }
+  zeroEnd = m_curPosition;
+  // Keep clusters with live entries and at least one cluster.
+  if (!seekSet(dst.position ? dst.position : 1)) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  keep = ((m_curPosition - 1) | m_vol->clusterMask()) + 1;
+  if (isContiguous()) {
+    nc = m_dataLength >> m_vol->bytesPerClusterShift();
+    nk = keep >> m_vol->bytesPerClusterShift();
+    if (nc > nk) {
+      toFree = m_firstCluster + nk;
+      if (!m_vol->bitmapModify(toFree, nc - nk, 0)) {
+        DBG_FAIL_MACRO;
+        goto fail;
+      }
+    }
+  } else {
+    fg = m_vol->fatGet(m_curCluster, &toFree);
+    if (fg < 0) {
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+  }
+  if (toFree && zeroEnd > keep) {
+    zeroEnd = keep;
+  }
+  // Mark remaining entries unused.
+  while (dst.position < zeroEnd) {
+    cache = m_vol->dirCache(&dst, FsCache::CACHE_FOR_WRITE);
+    if (!cache) {
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+    memset(cache, 0, FS_DIR_SIZE);
+    if (m_vol->dirSeek(&dst, FS_DIR_SIZE) < 0) {
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+  }
+  if (toFree && !isContiguous()) {
+    if (!m_vol->fatPut(m_curCluster, EXFAT_EOC) ||
+        !m_vol->freeChain(toFree)) {
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+  }
+  if (toFree && !isRoot()) {
+    m_dataLength = keep;
+    m_validLength = keep;
+    m_flags |= FILE_FLAG_DIR_DIRTY;
+  }
+  rewind();
+  return sync();
+
 fail:
   return false;
 }
@@ -219,15 +329,21 @@ fail:
   return false;
 }
 //------------------------------------------------------------------------------
-bool ExFatFile::preAllocate(uint64_t length) {
-  uint32_t find;
+bool ExFatFile::preAllocate(uint64_t length, bool alignAu) {
+  uint32_t find = 1;
   uint32_t need;
-  if (!length || !isWritable() || m_firstCluster) {
+  if (!length || !isFile() || !isWritable() || m_firstCluster) {
     DBG_FAIL_MACRO;
     goto fail;
   }
   need = 1 + ((length - 1) >> m_vol->bytesPerClusterShift());
-  find = m_vol->bitmapFind(0, need);
+  if (alignAu) {
+    find = m_vol->bitmapFind(0, need, m_vol->allocationUnitSectors());
+  }
+  if (find == 1) {
+    // No space at an allocation unit boundary.
+    find = m_vol->bitmapFind(0, need);
+  }
   if (find < 2) {
     DBG_FAIL_MACRO;
     goto fail;
@@ -249,9 +365,21 @@ fail:
   return false;
 }
 //------------------------------------------------------------------------------
+// Sectors past valid length in a contiguous file.
+uint32_t ExFatFile::preEraseCount() {
+  if (!isContiguous() || m_curPosition < m_validLength ||
+      m_curPosition >= m_dataLength) {
+    return 0;
+  }
+  uint64_t ns = (m_dataLength - m_curPosition + m_vol->sectorMask()) >>
+                m_vol->bytesPerSectorShift();
+  return ns < 0XFFFFFFFF ? ns : 0XFFFFFFFF;
+}
+//------------------------------------------------------------------------------
 bool ExFatFile::remove() {
   uint8_t* cache;
-  if (!isWritable()) {
+  // Can't remove if not a file open for write.  Use rmdir() for directories.
+  if (!isFile() || !isWritable()) {
     DBG_FAIL_MACRO;
     goto fail;
   }
@@ -365,6 +493,7 @@ fail:
 }
 //------------------------------------------------------------------------------
 bool ExFatFile::sync() {
+  FS_FILE_STATS_SCOPE(isOpen() ? &m_vol->m_stats : nullptr);
   if (!isOpen()) {
     return true;
   }
@@ -540,7 +669,7 @@ fail:
 bool ExFatFile::truncate() {
   uint32_t toFree;
   // error if not a normal file or read-only
-  if (!isWritable()) {
+  if (!isFile() || !isWritable()) {
     DBG_FAIL_MACRO;
     goto fail;
   }
@@ -597,6 +726,7 @@ fail:
 }
 //------------------------------------------------------------------------------
 size_t ExFatFile::write(const void* buf, size_t nbyte) {
+  FS_FILE_STATS_SCOPE(isOpen() ? &m_vol->m_stats : nullptr);
   // convert void* to uint8_t*  -  must be before goto statements
   const uint8_t* src = reinterpret_cast<const uint8_t*>(buf);
   uint8_t* cache;
@@ -608,8 +738,8 @@ size_t ExFatFile::write(const void* buf, size_t nbyte) {
   size_t toWrite = nbyte;
   size_t n;
 
-  // error if not an open file or is read-only
-  if (!isWritable()) {
+  // error if not a normal file or is read-only
+  if (!isFile() || !isWritable()) {
     DBG_FAIL_MACRO;
     goto fail;
   }
@@ -723,11 +853,18 @@ size_t ExFatFile::write(const void* buf, size_t nbyte) {
         ns = maxNs;
       }
       n = ns << m_vol->bytesPerSectorShift();
-      if (!m_vol->cacheSafeWrite(sector, src, ns)) {
+      if (!m_vol->cacheSafeWrite(sector, src, ns, preEraseCount())) {
         DBG_FAIL_MACRO;
         goto fail;
       }
 #endif  // USE_MULTI_SECTOR_IO
+    } else if (preEraseCount() > 1) {
+      // single sector in a stream to a preallocated file
+      n = m_vol->bytesPerSector();
+      if (!m_vol->cacheSafeWrite(sector, src, 1, preEraseCount())) {
+        DBG_FAIL_MACRO;
+        goto fail;
+      }
     } else {
       n = m_vol->bytesPerSector();
       if (!m_vol->cacheSafeWrite(sector, src)) {
@@ -755,6 +892,8 @@ size_t ExFatFile::write(const void* buf, size_t nbyte) {
     // insure sync will update modified date and time
     m_flags |= FILE_FLAG_DIR_DIRTY;
   }
+  FS_STATS_ADD(&m_vol->m_stats, fileWrites, 1);
+  FS_STATS_ADD(&m_vol->m_stats, fileWriteBytes, nbyte);
   return nbyte;
 
 fail:
@@ -27,11 +27,12 @@
 #include "../common/upcase.h"
 #include "ExFatLib.h"
 //------------------------------------------------------------------------------
-// Formatter assumes 512 byte sectors.
 const uint32_t BOOT_BACKUP_OFFSET = 12;
-const uint16_t BYTES_PER_SECTOR = 512;
+const uint16_t BYTES_PER_SECTOR = FS_SECTOR_SIZE;
 const uint16_t SECTOR_MASK = BYTES_PER_SECTOR - 1;
-const uint8_t BYTES_PER_SECTOR_SHIFT = 9;
+const uint8_t BYTES_PER_SECTOR_SHIFT = FS_SECTOR_SIZE_SHIFT;
+// Shift from 512 byte units to sectors.
+const uint8_t SECTOR_UNIT_SHIFT = BYTES_PER_SECTOR_SHIFT - 9;
 const uint16_t MINIMUM_UPCASE_SKIP = 512;
 const Cluster_t BITMAP_CLUSTER = 2;
 const Cluster_t UPCASE_CLUSTER = 3;
@@ -48,7 +49,8 @@ const Cluster_t ROOT_CLUSTER = 4;
   if (pr) pr->write(str)
 #endif  // PRINT_FORMAT_PROGRESS
 //------------------------------------------------------------------------------
-bool ExFatFormatter::format(FsBlockDevice* dev, uint8_t* secBuf, print_t* pr) {
+bool ExFatFormatter::format(FsBlockDevice* dev, uint8_t* secBuf, print_t* pr,
+                            size_t bufSectors) {
 #if !PRINT_FORMAT_PROGRESS
   (void)pr;
 #endif  //  !PRINT_FORMAT_PROGRESS
@@ -75,19 +77,22 @@ bool ExFatFormatter::format(FsBlockDevice* dev, uint8_t* secBuf, print_t* pr) {
 
   m_dev = dev;
   m_secBuf = secBuf;
+  m_bufSectors = bufSectors ? bufSectors : 1;
   sectorCount = dev->sectorCount();
   // Min size is 512 MB
-  if (sectorCount < 0X100000) {
+  if (sectorCount < (0X100000UL >> SECTOR_UNIT_SHIFT)) {
     writeMsg(pr, "Device is too small\r\n");
     DBG_FAIL_MACRO;
     goto fail;
   }
-  // Determine partition layout.
+  // Determine partition layout.  The layout is chosen in 512 byte units
+  // then scaled to the sector size.
   for (m = 1, vs = 0; m && sectorCount > m; m <<= 1, vs++) {
   }
-  sectorsPerClusterShift = vs < 29 ? 8 : (vs - 11) / 2;
+  vs += SECTOR_UNIT_SHIFT;
+  sectorsPerClusterShift = (vs < 29 ? 8 : (vs - 11) / 2) - SECTOR_UNIT_SHIFT;
   sectorsPerCluster = 1UL << sectorsPerClusterShift;
-  fatLength = 1UL << (vs < 27 ? 13 : (vs + 1) / 2);
+  fatLength = 1UL << ((vs < 27 ? 13 : (vs + 1) / 2) - SECTOR_UNIT_SHIFT);
   fatOffset = fatLength;
   partitionOffset = 2 * fatLength;
   clusterHeapOffset = 2 * fatLength;
@@ -163,7 +168,8 @@ bool ExFatFormatter::format(FsBlockDevice* dev, uint8_t* secBuf, print_t* pr) {
   sector++;
   // Write eight Extended Boot Sectors.
   memset(secBuf, 0, BYTES_PER_SECTOR);
-  setLe16(pbs->signature, PBR_SIGNATURE);
+  // Signature is in the last two bytes of an Extended Boot Sector.
+  setLe16(secBuf + BYTES_PER_SECTOR - 2, PBR_SIGNATURE);
   for (int j = 0; j < 8; j++) {
     for (size_t i = 0; i < BYTES_PER_SECTOR; i++) {
       checksum = exFatChecksum(checksum, secBuf[i]);
@@ -208,17 +214,10 @@ bool ExFatFormatter::format(FsBlockDevice* dev, uint8_t* secBuf, print_t* pr) {
   for (size_t i = 1; i < 20; i++) {
     secBuf[i] = 0XFF;
   }
-  for (uint32_t i = 0; i < ns; i++) {
-    if (i % (ns / 32) == 0) {
-      writeMsg(pr, ".");
-    }
-    if (!dev->writeSector(sector + i, secBuf)) {
-      DBG_FAIL_MACRO;
-      goto fail;
-    }
-    if (i == 0) {
-      memset(secBuf, 0, BYTES_PER_SECTOR);
-    }
+  if (!dev->writeSector(sector, secBuf) ||
+      !writeZeros(sector + 1, ns - 1, pr)) {
+    DBG_FAIL_MACRO;
+    goto fail;
   }
   writeMsg(pr, "\r\n");
   // Write cluster two, bitmap.
@@ -232,14 +231,10 @@ bool ExFatFormatter::format(FsBlockDevice* dev, uint8_t* secBuf, print_t* pr) {
   memset(secBuf, 0, BYTES_PER_SECTOR);
   // Allocate clusters for bitmap, upcase, and root.
   secBuf[0] = 0X7;
-  for (uint32_t i = 0; i < ns; i++) {
-    if (!dev->writeSector(sector + i, secBuf)) {
-      DBG_FAIL_MACRO;
-      goto fail;
-    }
-    if (i == 0) {
-      secBuf[0] = 0;
-    }
+  if (!dev->writeSector(sector, secBuf) ||
+      !writeZeros(sector + 1, ns - 1, nullptr)) {
+    DBG_FAIL_MACRO;
+    goto fail;
   }
   // Write cluster three, upcase table.
   writeMsg(pr, "Writing upcase table\r\n");
@@ -275,14 +270,10 @@ bool ExFatFormatter::format(FsBlockDevice* dev, uint8_t* secBuf, print_t* pr) {
   setLe64(dup->size, m_upcaseSize);
 
   // Write root, cluster four.
-  for (uint32_t i = 0; i < ns; i++) {
-    if (!dev->writeSector(sector + i, secBuf)) {
-      DBG_FAIL_MACRO;
-      goto fail;
-    }
-    if (i == 0) {
-      memset(secBuf, 0, BYTES_PER_SECTOR);
-    }
+  if (!dev->writeSector(sector, secBuf) ||
+      !writeZeros(sector + 1, ns - 1, nullptr)) {
+    DBG_FAIL_MACRO;
+    goto fail;
   }
   writeMsg(pr, "Format done\r\n");
   return true;
@@ -365,3 +356,31 @@ bool ExFatFormatter::writeUpcase(Sector_t sector) {
 fail:
   return false;
 }
+//------------------------------------------------------------------------------
+bool ExFatFormatter::writeZeros(Sector_t sector, uint32_t count,
+                                print_t* pr) {
+#if !PRINT_FORMAT_PROGRESS
+  (void)pr;
+#endif  //  !PRINT_FORMAT_PROGRESS
+  uint32_t dotStep = count / 32 ? count / 32 : 1;
+  uint32_t nextDot = dotStep;
+  uint32_t done = 0;
+  if (count == 0 || m_dev->zeroSectors(sector, sector + count - 1)) {
+    return true;
+  }
+  memset(m_secBuf, 0, m_bufSectors * BYTES_PER_SECTOR);
+  while (done < count) {
+    uint32_t n = count - done;
+    if (n > m_bufSectors) {
+      n = m_bufSectors;
+    }
+    if (!m_dev->writeSectors(sector + done, m_secBuf, n)) {
+      return false;
+    }
+    done += n;
+    for (; nextDot <= done; nextDot += dotStep) {
+      writeMsg(pr, ".");
+    }
+  }
+  return true;
+}
@@ -38,19 +38,24 @@ class ExFatFormatter {
    * \param[in] dev Block device for volume.
    * \param[in] secBuf buffer for writing to volume.
    * \param[in] pr Print device for progress output.
+   * \param[in] bufSectors Size of secBuf in sectors.  A larger buffer
+   * allows fewer, larger writes when zeroing the FAT, bitmap and root.
    *
    * \return true for success or false for failure.
    */
-  bool format(FsBlockDevice* dev, uint8_t* secBuf, print_t* pr = nullptr);
+  bool format(FsBlockDevice* dev, uint8_t* secBuf, print_t* pr = nullptr,
+              size_t bufSectors = 1);
 
  private:
   bool syncUpcase();
   bool writeUpcase(Sector_t sector);
   bool writeUpcaseByte(uint8_t b);
   bool writeUpcaseUnicode(uint16_t unicode);
+  bool writeZeros(Sector_t sector, uint32_t count, print_t* pr);
   Sector_t m_upcaseSector;
   uint32_t m_upcaseChecksum;
   uint32_t m_upcaseSize;
   FsBlockDevice* m_dev;
   uint8_t* m_secBuf;
+  size_t m_bufSectors;
 };
@@ -46,6 +46,18 @@ inline uint16_t exFatHash(uint16_t u, uint16_t hash) {
 //------------------------------------------------------------------------------
 bool ExFatFile::cmpName(const DirName_t* dirName, ExName_t* fname) {
   for (uint8_t i = 0; i < 15; i++) {
+    if (i < 12 && fname->has4()) {
+      // Try four ASCII characters at a time.
+      int8_t cmp = cmpUpcaseAscii4(dirName->unicode + 2 * i, fname->next);
+      if (cmp == 0) {
+        return false;
+      }
+      if (cmp > 0) {
+        fname->next += 4;
+        i += 3;
+        continue;
+      }
+    }
     uint16_t u = getLe16(dirName->unicode + 2 * i);
     if (fname->atEnd()) {
       return u == 0;
@@ -117,6 +129,16 @@ size_t ExFatFile::getName8(char* name, size_t count) {
       goto fail;
     }
     for (uint8_t in = 0; in < 15; in++) {
+      if (!hs) {
+        // Copy a run of ASCII characters.  Save space for zero byte.
+        size_t n =
+            FsUtf::u16ToAscii(dn->unicode + 2 * in, 15 - in, str, end - 1);
+        str += n;
+        in += n;
+        if (in == 15) {
+          break;
+        }
+      }
       uint16_t c = getLe16(dn->unicode + 2 * in);
       if (hs) {
         if (!FsUtf::isLowSurrogate(c)) {
@@ -161,6 +183,15 @@ bool ExFatFile::hashName(ExName_t* fname) {
 #if USE_UTF8_LONG_NAMES
   fname->nameLength = 0;
   while (!fname->atEnd()) {
+    // Hash a run of ASCII characters without UTF-8 decode.
+    size_t n = fname->ls ? 0 : FsUtf::asciiLength(fname->next, fname->end);
+    if (n) {
+      fname->nameLength += n;
+      while (n--) {
+        hash = exFatHash(*fname->next++, hash);
+      }
+      continue;
+    }
     uint16_t u = fname->get16();
     if (u == 0XFFFF) {
       DBG_FAIL_MACRO;
@@ -27,7 +27,8 @@
 #include "ExFatLib.h"
 //------------------------------------------------------------------------------
 // return 0 if error, 1 if no space, else start cluster.
-Cluster_t ExFatPartition::bitmapFind(Cluster_t cluster, uint32_t count) {
+Cluster_t ExFatPartition::bitmapFind(Cluster_t cluster, uint32_t count,
+                                     Sector_t align) {
   Cluster_t start = cluster > 1 ? cluster - 2 : m_bitmapStart;
   start = start >= m_clusterCount ? 0 : start;
   Cluster_t n = 0;
@@ -36,6 +37,7 @@ Cluster_t ExFatPartition::bitmapFind(Cluster_t cluster, uint32_t count) {
   size_t i = (start >> 3) & m_sectorMask;
   const uint8_t* cache;
   uint8_t mask = 1 << (start & 7);
+  FS_STATS_ADD(&m_stats, bitmapFinds, 1);
   while (true) {
     Sector_t sector =
         m_clusterHeapStartSector + (endAlloc >> (m_bytesPerSectorShift + 3));
@@ -55,7 +57,11 @@ Cluster_t ExFatPartition::bitmapFind(Cluster_t cluster, uint32_t count) {
           break;
         }
         if (!(mask & cache[i])) {
-          if ((endAlloc - bgnAlloc) == count) {
+          if (align && (bgnAlloc + 1) == endAlloc &&
+              clusterStartSector(bgnAlloc + 2) % align) {
+            // Run must start at a boundary.
+            bgnAlloc = endAlloc;
+          } else if ((endAlloc - bgnAlloc) == count) {
             if (cluster == 0 && count == 1) {
               // Start at found sector.  bitmapModify may increase this.
               m_bitmapStart = bgnAlloc;
@@ -86,10 +92,12 @@ bool ExFatPartition::bitmapModify(Cluster_t cluster, uint32_t count,
     goto fail;
   }
   if (value) {
+    discardCancel(start + 2, count);
     if (start <= m_bitmapStart && m_bitmapStart < (start + count)) {
       m_bitmapStart = (start + count) < m_clusterCount ? start + count : 0;
     }
   } else {
+    discardAdd(start + 2, count);
     if (start < m_bitmapStart) {
       m_bitmapStart = start;
     }
@@ -165,6 +173,7 @@ int8_t ExFatPartition::fatGet(Cluster_t cluster, Cluster_t* value) {
   const uint8_t* cache;
   Cluster_t next;
   Sector_t sector;
+  FS_STATS_ADD(&m_stats, fatGets, 1);
 
   if (cluster > (m_clusterCount + 1)) {
     DBG_FAIL_MACRO;
@@ -187,6 +196,7 @@ int8_t ExFatPartition::fatGet(Cluster_t cluster, Cluster_t* value) {
 bool ExFatPartition::fatPut(Cluster_t cluster, Cluster_t value) {
   Sector_t sector;
   uint8_t* cache;
+  FS_STATS_ADD(&m_stats, fatPuts, 1);
   if (cluster < 2 || cluster > (m_clusterCount + 1)) {
     DBG_FAIL_MACRO;
     goto fail;
@@ -271,6 +281,9 @@ bool ExFatPartition::init(FsBlockDevice* dev, uint8_t part,
   m_fatType = 0;
   m_blockDev = dev;
   cacheInit(m_blockDev);
+#if USE_DISCARD_FREE_CLUSTERS
+  m_discard.init(dev->allocationUnitSectors());
+#endif  // USE_DISCARD_FREE_CLUSTERS
   // if part == 0 assume super floppy with FAT boot sector in sector zero
   // if part > 0 assume mbr volume with partition table
   if (part) {
@@ -29,6 +29,7 @@
  */
 #include "../common/FsBlockDevice.h"
 #include "../common/FsCache.h"
+#include "../common/FsDiscard.h"
 #include "../common/FsStructs.h"
 #include "../common/SysCall.h"
 /** Set EXFAT_READ_ONLY non-zero for read only */
@@ -113,6 +114,12 @@ class ExFatPartition {
    * \return true if busy else false.
    */
   bool isBusy() { return m_blockDev->isBusy(); }
+#if USE_FS_STATS
+  /** Set the operation counters to zero. */
+  void clearStats() { m_stats.clear(); }
+  /** \return A snapshot of the operation counters. */
+  FsStats stats() const { return m_stats; }
+#endif  // USE_FS_STATS
   /** \return the root directory start cluster number. */
   Cluster_t rootDirectoryCluster() const { return m_rootDirectoryCluster; }
   /** \return the root directory length. */
@@ -138,7 +145,10 @@ class ExFatPartition {
  private:
   /** ExFatFile allowed access to private members. */
   friend class ExFatFile;
-  uint32_t bitmapFind(Cluster_t cluster, uint32_t count);
+  uint32_t bitmapFind(Cluster_t cluster, uint32_t count, Sector_t align = 0);
+  Sector_t allocationUnitSectors() {
+    return m_blockDev->allocationUnitSectors();
+  }
   bool bitmapModify(Cluster_t cluster, uint32_t count, bool value);
   //----------------------------------------------------------------------------
   // Cache functions.
@@ -154,12 +164,20 @@ class ExFatPartition {
     m_bitmapCache.init(dev);
 #endif  // USE_EXFAT_BITMAP_CACHE
     m_dataCache.init(dev);
+#if USE_FS_STATS
+    m_stats.clear();
+#if USE_EXFAT_BITMAP_CACHE
+    m_bitmapCache.setStats(&m_stats);
+#endif  // USE_EXFAT_BITMAP_CACHE
+    m_dataCache.setStats(&m_stats);
+#endif  // USE_FS_STATS
   }
   bool cacheSync() {
 #if USE_EXFAT_BITMAP_CACHE
-    return m_bitmapCache.sync() && m_dataCache.sync() && syncDevice();
+    return m_bitmapCache.sync() && m_dataCache.sync() && syncDevice() &&
+           discardFlush();
 #else   // USE_EXFAT_BITMAP_CACHE
-    return m_dataCache.sync() && syncDevice();
+    return m_dataCache.sync() && syncDevice() && discardFlush();
 #endif  // USE_EXFAT_BITMAP_CACHE
   }
   void dataCacheDirty() { m_dataCache.dirty(); }
@@ -170,6 +188,30 @@ class ExFatPartition {
   Sector_t dataCacheSector() { return m_dataCache.sector(); }
   bool dataCacheSync() { return m_dataCache.sync(); }
   //----------------------------------------------------------------------------
+#if USE_DISCARD_FREE_CLUSTERS
+  FsDiscard m_discard;
+  void discardAdd(Cluster_t cluster, uint32_t count) {
+    m_discard.add(cluster, count);
+  }
+  void discardCancel(Cluster_t cluster, uint32_t count) {
+    m_discard.cancel(cluster, count);
+  }
+  bool discardFlush() {
+    return m_discard.flush(m_blockDev, m_clusterHeapStartSector,
+                           m_sectorsPerClusterShift);
+  }
+#else   // USE_DISCARD_FREE_CLUSTERS
+  void discardAdd(Cluster_t cluster, uint32_t count) {
+    (void)cluster;
+    (void)count;
+  }
+  void discardCancel(Cluster_t cluster, uint32_t count) {
+    (void)cluster;
+    (void)count;
+  }
+  bool discardFlush() { return true; }
+#endif  // USE_DISCARD_FREE_CLUSTERS
+  //----------------------------------------------------------------------------
   uint32_t clusterMask() const { return m_clusterMask; }
   Sector_t clusterStartSector(Cluster_t cluster) {
     return m_clusterHeapStartSector +
@@ -195,6 +237,10 @@ class ExFatPartition {
   bool cacheSafeWrite(Sector_t sector, const uint8_t* src, size_t count) {
     return m_dataCache.cacheSafeWrite(sector, src, count);
   }
+  bool cacheSafeWrite(Sector_t sector, const uint8_t* src, size_t count,
+                      uint32_t eraseCount) {
+    return m_dataCache.cacheSafeWrite(sector, src, count, eraseCount);
+  }
   bool readSector(Sector_t sector, uint8_t* dst) {
     return m_blockDev->readSector(sector, dst);
   }
@@ -202,7 +248,7 @@ class ExFatPartition {
     return m_blockDev->writeSector(sector, src);
   }
   //----------------------------------------------------------------------------
-  static const uint8_t m_bytesPerSectorShift = 9;
+  static const uint8_t m_bytesPerSectorShift = FS_SECTOR_SIZE_SHIFT;
   static const uint16_t m_bytesPerSector = 1 << m_bytesPerSectorShift;
   static const uint16_t m_sectorMask = m_bytesPerSector - 1;
   //----------------------------------------------------------------------------
@@ -210,6 +256,9 @@ class ExFatPartition {
   FsCache m_bitmapCache;
 #endif  // USE_EXFAT_BITMAP_CACHE
   FsCache m_dataCache;
+#if USE_FS_STATS
+  FsStats m_stats;
+#endif  // USE_FS_STATS
   Sector_t m_bitmapStart;
   Sector_t m_fatStartSector;
   uint32_t m_fatLength;
@@ -184,12 +184,12 @@ void FatFile::dmpFile(print_t* pr, uint32_t pos, size_t n) {
 }
 //------------------------------------------------------------------------------
 bool FatPartition::dmpDirSector(print_t* pr, Sector_t sector) {
-  DirFat_t dir[16];
+  DirFat_t dir[FS_SECTOR_SIZE / FS_DIR_SIZE];
   if (!cacheSafeRead(sector, reinterpret_cast<uint8_t*>(dir))) {
     pr->println(F("dmpDir failed"));
     return false;
   }
-  for (uint8_t i = 0; i < 16; i++) {
+  for (uint16_t i = 0; i < FS_SECTOR_SIZE / FS_DIR_SIZE; i++) {
     if (!printFatDir(pr, dir + i)) {
       return false;
     }
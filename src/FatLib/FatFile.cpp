@@ -119,7 +119,7 @@ DirFat_t* FatFile::cacheDirEntry(uint8_t action) {
     DBG_FAIL_MACRO;
     goto fail;
   }
-  return dir + (m_dirIndex & 0XF);
+  return dir + (m_dirIndex & (m_vol->bytesPerSector() / FS_DIR_SIZE - 1));
 
 fail:
   return nullptr;
@@ -132,6 +132,98 @@ bool FatFile::close() {
   return rtn;
 }
 //------------------------------------------------------------------------------
+bool FatFile::compact() {
+  DirFat_t entry;
+  DirFat_t* dir;
+  FatFile dst;
+  Cluster_t toFree = 0;
+  uint32_t endPosition;
+  uint32_t zeroEnd;
+
+  if (!isDir() || !isWritable()) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  rewind();
+  dst.copy(this);
+  // Move live entries down over deleted entries.
+  while (1) {
+    dir = readDirCache();
+    if (!dir) {
+      if (getError()) {
+        DBG_FAIL_MACRO;
+        goto fail;
+      }
+      // EOF if no error.
+      break;
+    }
+    if (dir->name[0] == FAT_NAME_FREE) {
+      break;
+    }
+    if (dir->name[0] == FAT_NAME_DELETED) {
+      continue;
+    }
+    if ((dst.m_curPosition + FS_DIR_SIZE) == m_curPosition) {
+      // Entry is in place.
+      if (!dst.seekSet(m_curPosition)) {
+        DBG_FAIL_MACRO;
+        goto fail;
+      }
+      continue;
+    }
+    memcpy(&entry, dir, sizeof(entry));
+    dir = dst.readDirCache();
+    if (!dir) {
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+    memcpy(dir, &entry, sizeof(entry));
+    m_vol->cacheDirty();
+  }
+  endPosition = dst.m_curPosition;
+  zeroEnd = m_curPosition;
+  if (!isRootFixed()) {
+    // Keep clusters with live entries and at least one cluster.
+    if (!seekSet(endPosition ? endPosition : 1)) {
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+    int8_t fg = m_vol->fatGet(m_curCluster, &toFree);
+    if (fg < 0) {
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+    if (fg) {
+      // Only zero entries in the last cluster that is kept.
+      uint32_t keep = (m_curPosition - 1) | (m_vol->bytesPerCluster() - 1);
+      if (zeroEnd > (keep + 1)) {
+        zeroEnd = keep + 1;
+      }
+    }
+  }
+  // Mark remaining entries free.
+  while (dst.m_curPosition < zeroEnd) {
+    dir = dst.readDirCache();
+    if (!dir) {
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+    memset(dir, 0, sizeof(DirFat_t));
+    m_vol->cacheDirty();
+  }
+  if (toFree) {
+    if (!m_vol->fatPutEOC(m_curCluster) || !m_vol->freeChain(toFree)) {
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+  }
+  rewind();
+  return m_vol->cacheSync();
+
+fail:
+  return false;
+}
+//------------------------------------------------------------------------------
 bool FatFile::contiguousRange(Sector_t* bgnSector, Sector_t* endSector) {
   // error if no clusters
   if (!isFile() || m_firstCluster == 0) {
@@ -230,12 +322,15 @@ uint32_t FatFile::dirSize() {
   Cluster_t c = isRoot32() ? m_vol->rootDirStart() : m_firstCluster;
   do {
     fg = m_vol->fatGet(c, &c);
-    if (fg < 0 || n > 4095) {
+    // Max directory size is 65536 entries or 2 MiB.
+    if (fg < 0 ||
+        (static_cast<uint32_t>(n) << m_vol->bytesPerSectorShift()) >=
+            (FS_DIR_SIZE * 0X10000UL)) {
       return 0;
     }
     n += m_vol->sectorsPerCluster();
   } while (fg);
-  return 512UL * n;
+  return static_cast<uint32_t>(n) << m_vol->bytesPerSectorShift();
 }
 //------------------------------------------------------------------------------
 int FatFile::fgets(char* str, int num, const char* delim) {
@@ -458,7 +553,17 @@ bool FatFile::open(FatFile* dirFile, const char* path, oflag_t oflag) {
       path++;
     }
     if (*path == 0) {
-      return openRoot(dirFile->m_vol);
+      // Same access rules as a subdirectory.
+      oflag_t mode = oflag & (O_ACCMODE | O_TRUNC | O_APPEND);
+      if ((mode != O_RDONLY && mode != O_RDWR) ||
+          !openRoot(dirFile->m_vol)) {
+        DBG_FAIL_MACRO;
+        goto fail;
+      }
+      if ((oflag & O_ACCMODE) == O_RDWR) {
+        m_flags |= FILE_FLAG_WRITE;
+      }
+      return true;
     }
     if (!tmpDir.openRoot(dirFile->m_vol)) {
       DBG_FAIL_MACRO;
@@ -543,7 +648,7 @@ bool FatFile::openCachedEntry(FatFile* dirFile, uint16_t dirIndex,
   m_dirIndex = dirIndex;
   m_dirCluster = dirFile->m_firstCluster;
   DirFat_t* dir = reinterpret_cast<DirFat_t*>(m_vol->cacheAddress());
-  dir += 0XF & dirIndex;
+  dir += (m_vol->bytesPerSector() / FS_DIR_SIZE - 1) & dirIndex;
 
   // Must be file or subdirectory.
   if (!isFatFileOrSubdir(dir)) {
@@ -579,7 +684,10 @@ bool FatFile::openCachedEntry(FatFile* dirFile, uint16_t dirIndex,
   }
 
   if (m_flags & FILE_FLAG_WRITE) {
-    if (isSubDir() || isReadOnly()) {
+    // A directory may only be opened O_RDWR, for compact().
+    if ((isSubDir() &&
+         (oflag & (O_ACCMODE | O_TRUNC | O_APPEND)) != O_RDWR) ||
+        isReadOnly()) {
       DBG_FAIL_MACRO;
       goto fail;
     }
@@ -608,6 +716,10 @@ bool FatFile::openCachedEntry(FatFile* dirFile, uint16_t dirIndex,
     DBG_FAIL_MACRO;
     goto fail;
   }
+#if USE_FS_FILE_STATS
+  // Do not charge the open to the file.
+  m_stats.clear();
+#endif  // USE_FS_FILE_STATS
   return true;
 
 fail:
@@ -617,14 +729,18 @@ fail:
 }
 //------------------------------------------------------------------------------
 bool FatFile::openCluster(FatFile* file) {
-  if (file->m_dirCluster == 0) {
-    return openRoot(file->m_vol);
+  return openCluster(file->m_vol, file->m_dirCluster);
+}
+//------------------------------------------------------------------------------
+bool FatFile::openCluster(FatVolume* vol, Cluster_t cluster) {
+  if (cluster == 0) {
+    return openRoot(vol);
   }
   memset(this, 0, sizeof(FatFile));
   m_attributes = FILE_ATTR_SUBDIR;
   m_flags = FILE_FLAG_READ;
-  m_vol = file->m_vol;
-  m_firstCluster = file->m_dirCluster;
+  m_vol = vol;
+  m_firstCluster = cluster;
   return true;
 }
 //------------------------------------------------------------------------------
@@ -736,15 +852,18 @@ int FatFile::peek() {
   return c;
 }
 //------------------------------------------------------------------------------
-bool FatFile::preAllocate(uint32_t length) {
+bool FatFile::preAllocate(uint32_t length, bool alignAu) {
   uint32_t need;
-  if (!length || !isWritable() || m_firstCluster) {
+  bool found;
+  if (!length || !isFile() || !isWritable() || m_firstCluster) {
     DBG_FAIL_MACRO;
     goto fail;
   }
   need = 1 + ((length - 1) >> m_vol->bytesPerClusterShift());
-  // allocate clusters
-  if (!m_vol->allocContiguous(need, &m_firstCluster)) {
+  // allocate clusters, try an allocation unit boundary first
+  found = alignAu && m_vol->allocContiguous(need, &m_firstCluster,
+                                            m_vol->allocationUnitSectors());
+  if (!found && !m_vol->allocContiguous(need, &m_firstCluster)) {
     DBG_FAIL_MACRO;
     goto fail;
   }
@@ -763,6 +882,22 @@ fail:
   return false;
 }
 //------------------------------------------------------------------------------
+// Sectors of a preallocated file that have not been written.
+uint32_t FatFile::preEraseCount() {
+  if (!(m_flags & FILE_FLAG_PREALLOCATE) || m_curPosition >= m_fileSize) {
+    return 0;
+  }
+  return (m_fileSize - m_curPosition + m_vol->sectorMask()) >>
+         m_vol->bytesPerSectorShift();
+}
+//------------------------------------------------------------------------------
+#if USE_FS_FILE_STATS
+int FatFile::read(void* buf, size_t count) {
+  FS_FILE_STATS_SCOPE(isOpen() ? &m_vol->m_stats : nullptr);
+  return readPrivate(buf, count, nullptr);
+}
+#endif  // USE_FS_FILE_STATS
+//------------------------------------------------------------------------------
 int FatFile::readPrivate(void* buf, size_t nbyte, DirFat_t** cache) {
   int8_t fg;
   uint8_t sectorOfCluster = 0;
@@ -872,6 +1007,10 @@ int FatFile::readPrivate(void* buf, size_t nbyte, DirFat_t** cache) {
     m_curPosition += n;
     toRead -= n;
   }
+  if (isFile()) {
+    FS_STATS_ADD(&m_vol->m_stats, fileReads, 1);
+    FS_STATS_ADD(&m_vol->m_stats, fileReadBytes, nbyte - toRead);
+  }
   return nbyte - toRead;
 
 fail:
@@ -1231,6 +1370,7 @@ fail:
 bool FatFile::sync() {
   uint16_t date, time;
   uint8_t ms10;
+  FS_FILE_STATS_SCOPE(isOpen() ? &m_vol->m_stats : nullptr);
   if (!isOpen()) {
     return true;
   }
@@ -1317,7 +1457,7 @@ fail:
 bool FatFile::truncate() {
   uint32_t toFree;
   // error if not a normal file or read-only
-  if (!isWritable()) {
+  if (!isFile() || !isWritable()) {
     DBG_FAIL_MACRO;
     goto fail;
   }
@@ -1354,11 +1494,70 @@ bool FatFile::truncate() {
   m_flags |= FILE_FLAG_DIR_DIRTY;
   return sync();
 
+fail:
+  return false;
+}
+//------------------------------------------------------------------------------
+bool FatFile::walk(FatWalkCallback_t callback, void* context) {
+  // Directory to resume after a subdirectory is done.
+  struct {
+    Cluster_t cluster;
+    Cluster_t curCluster;
+    uint32_t position;
+  } stack[WALK_MAX_DEPTH];
+  uint8_t depth = 0;
+  FatFile dir;
+  FatFile file;
+  if (!isDir()) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  dir.copy(this);
+  dir.rewind();
+  while (1) {
+    if (!file.openNext(&dir, O_RDONLY)) {
+      if (dir.getError()) {
+        DBG_FAIL_MACRO;
+        goto fail;
+      }
+      if (depth == 0) {
+        break;
+      }
+      depth--;
+      dir.close();
+      if (!dir.openCluster(m_vol, stack[depth].cluster)) {
+        DBG_FAIL_MACRO;
+        goto fail;
+      }
+      // Resume without following the cluster chain from the start.
+      dir.m_curCluster = stack[depth].curCluster;
+      dir.m_curPosition = stack[depth].position;
+      continue;
+    }
+    uint8_t rtn = callback(&file, depth, context);
+    if (rtn == WALK_STOP) {
+      file.close();
+      break;
+    }
+    // Do not descend below WALK_MAX_DEPTH, same as WALK_SKIP.
+    if (rtn != WALK_SKIP && file.isSubDir() && depth < WALK_MAX_DEPTH) {
+      stack[depth].cluster = dir.m_firstCluster;
+      stack[depth].curCluster = dir.m_curCluster;
+      stack[depth].position = dir.m_curPosition;
+      depth++;
+      dir.copy(&file);
+      dir.rewind();
+    }
+    file.close();
+  }
+  return true;
+
 fail:
   return false;
 }
 //------------------------------------------------------------------------------
 size_t FatFile::write(const void* buf, size_t nbyte) {
+  FS_FILE_STATS_SCOPE(isOpen() ? &m_vol->m_stats : nullptr);
   // convert void* to uint8_t*  -  must be before goto statements
   const uint8_t* src = reinterpret_cast<const uint8_t*>(buf);
   uint8_t* pc;
@@ -1367,7 +1566,7 @@ size_t FatFile::write(const void* buf, size_t nbyte) {
   size_t nToWrite = nbyte;
   size_t n;
   // error if not a normal file or is read-only
-  if (!isWritable()) {
+  if (!isFile() || !isWritable()) {
     DBG_FAIL_MACRO;
     goto fail;
   }
@@ -1471,11 +1670,18 @@ size_t FatFile::write(const void* buf, size_t nbyte) {
         nSector = maxSectors;
       }
       n = nSector << m_vol->bytesPerSectorShift();
-      if (!m_vol->cacheSafeWrite(sector, src, nSector)) {
+      if (!m_vol->cacheSafeWrite(sector, src, nSector, preEraseCount())) {
         DBG_FAIL_MACRO;
         goto fail;
       }
 #endif  // USE_MULTI_SECTOR_IO
+    } else if (preEraseCount() > 1) {
+      // single sector in a stream to a preallocated file
+      n = m_vol->bytesPerSector();
+      if (!m_vol->cacheSafeWrite(sector, src, 1, preEraseCount())) {
+        DBG_FAIL_MACRO;
+        goto fail;
+      }
     } else {
       // use single sector write command
       n = m_vol->bytesPerSector();
@@ -1496,6 +1702,8 @@ size_t FatFile::write(const void* buf, size_t nbyte) {
     // insure sync will update modified date and time
     m_flags |= FILE_FLAG_DIR_DIRTY;
   }
+  FS_STATS_ADD(&m_vol->m_stats, fileWrites, 1);
+  FS_STATS_ADD(&m_vol->m_stats, fileWriteBytes, nbyte);
   return nbyte;
 
 fail:
@@ -100,6 +100,11 @@ const uint8_t FNAME_FLAG_LC_BASE = FAT_CASE_LC_BASE;
 /** Filename extension is all lower case. */
 const uint8_t FNAME_FLAG_LC_EXT = FAT_CASE_LC_EXT;
 //==============================================================================
+class FatFile;
+/** Callback for FatFile::walk(). */
+typedef uint8_t (*FatWalkCallback_t)(FatFile* file, uint8_t depth,
+                                     void* context);
+//==============================================================================
 /**
  * \class FatFile
  * \brief Basic file class.
@@ -238,6 +243,21 @@ class FatFile {
    * \return true for success or false for failure.
    */
   bool close();
+  /** Compact a directory.
+   *
+   * Live directory entries are moved to the start of the directory,
+   * the remaining entries are marked free, and clusters that no longer
+   * contain live entries are freed.  This shortens directory scans after
+   * many files have been removed.
+   *
+   * The directory must be opened with O_RDWR.
+   *
+   * \note Files and subdirectories in the directory must be closed since
+   * their directory entries may be moved.
+   *
+   * \return true for success or false for failure.
+   */
+  bool compact();
   /** Check for contiguous file and return its raw sector range.
    *
    * \param[out] bgnSector the first sector address for the file.
@@ -632,9 +652,12 @@ class FatFile {
    * The file will contain uninitialized data.
    *
    * \param[in] length size of the file in bytes.
+   * \param[in] alignAu Start the file at an allocation unit boundary
+   * of the card if free space is available.  Streaming writes to whole
+   * allocation units are faster on most cards.
    * \return true for success or false for failure.
    */
-  bool preAllocate(uint32_t length);
+  bool preAllocate(uint32_t length, bool alignAu = false);
   /** Print a file's access date
    *
    * \param[in] pr Print stream for output.
@@ -794,7 +817,11 @@ class FatFile {
    * if end of file is reached.
    * If an error occurs, read() returns -1.
    */
+#if USE_FS_FILE_STATS
+  int read(void* buf, size_t count);
+#else   // USE_FS_FILE_STATS
   int read(void* buf, size_t count) { return readPrivate(buf, count, nullptr); }
+#endif  // USE_FS_FILE_STATS
   /** Read the next directory entry from a directory file.
    *
    * \param[out] dir The DirFat_t struct that will receive the data.
@@ -899,6 +926,14 @@ class FatFile {
    * \return true for success or false for failure.
    */
   bool seekSet(uint32_t pos);
+#if USE_FS_FILE_STATS
+  /** Set the operation counters for this file to zero. */
+  void clearStats() { m_stats.clear(); }
+  /** \return A snapshot of the volume counts caused by read(), write()
+   * and sync() calls since this file was opened or clearStats() was called.
+   */
+  FsStats stats() const { return m_stats; }
+#endif  // USE_FS_FILE_STATS
   /** The sync() call causes all modified data and directory fields
    * to be written to the storage device.
    *
@@ -955,6 +990,29 @@ class FatFile {
    * \return true for success or false for failure.
    */
   bool truncate(uint32_t length) { return seekSet(length) && truncate(); }
+  /** Walk the tree below this directory.
+   *
+   * Entries are visited in directory order and a subdirectory is visited
+   * before its contents.  The walk is iterative and streams through each
+   * directory once.  Ancestors are saved in a stack of WALK_MAX_DEPTH
+   * frames so no path lookups are done.  Each entry is opened from the
+   * cached directory sector and a parent resumes at its saved cluster.
+   *
+   * \param[in] callback Called for each entry with the open entry, the
+   * depth of the entry below this directory, and \a context.  The callback
+   * returns WALK_CONTINUE, WALK_SKIP to not descend into a subdirectory,
+   * or WALK_STOP to end the walk.
+   * \param[in] context Passed to \a callback.
+   *
+   * \note The entry is closed when the callback returns.  Files must not
+   * be created or removed during the walk.
+   *
+   * A subdirectory at depth WALK_MAX_DEPTH is passed to \a callback but
+   * its contents are not visited, as if \a callback returned WALK_SKIP.
+   *
+   * \return true for success or false for failure.
+   */
+  bool walk(FatWalkCallback_t callback, void* context = nullptr);
   /** Write a string to a file. Used by the Arduino Print class.
    * \param[in] str Pointer to the string.
    * Use getWriteError to check for errors.
@@ -1040,8 +1098,9 @@ class FatFile {
     return sum;
   }
   static bool makeSFN(FatLfn_t* fname);
-  bool makeUniqueSfn(FatLfn_t* fname);
+  bool makeUniqueSfn(FatLfn_t* fname, uint16_t hex);
   bool openCluster(FatFile* file);
+  bool openCluster(FatVolume* vol, Cluster_t cluster);
   bool parsePathName(const char* str, FatLfn_t* fname, const char** ptr);
   bool parsePathName(const char* str, FatSfn_t* fname, const char** ptr);
   bool mkdir(FatFile* parent, FatName_t* fname);
@@ -1051,6 +1110,7 @@ class FatFile {
   bool openCachedEntry(FatFile* dirFile, uint16_t cacheIndex, oflag_t oflag,
                        uint8_t lfnOrd);
   DirFat_t* readDirCache();
+  uint32_t preEraseCount();
   int readPrivate(void* buf, size_t nbyte, DirFat_t** cache);
   // bits defined in m_flags
   static const uint8_t FILE_FLAG_READ = 0X01;
@@ -1079,6 +1139,9 @@ class FatFile {
   Sector_t m_dirSector;      // sector for this files directory entry
   uint32_t m_fileSize;       // file size in bytes
   Cluster_t m_firstCluster;  // first cluster of file
+#if USE_FS_FILE_STATS
+  FsStats m_stats = {};  // Counters for this file.
+#endif                   // USE_FS_FILE_STATS
 };
 
 #include "../common/ArduinoFiles.h"
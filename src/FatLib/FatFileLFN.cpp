@@ -68,6 +68,19 @@ bool FatFile::cmpName(uint16_t index, FatLfn_t* fname, uint8_t lfnOrd) {
     DBG_HALT_IF(ldir->attributes != FAT_ATTRIB_LONG_NAME);
     DBG_HALT_IF(order != (ldir->order & 0X1F));
     for (uint8_t i = 0; i < 13; i++) {
+      if ((i == 0 || i == 5) && fname->has4()) {
+        // Try four ASCII characters at a time.
+        int8_t cmp =
+            cmpUpcaseAscii4(i ? ldir->unicode2 : ldir->unicode1, fname->next);
+        if (cmp == 0) {
+          return false;
+        }
+        if (cmp > 0) {
+          fname->next += 4;
+          i += 3;
+          continue;
+        }
+      }
       uint16_t u = getLfnChar(ldir, i);
       if (fname->atEnd()) {
         return u == 0;
@@ -215,28 +228,41 @@ fail:
   return false;
 }
 //------------------------------------------------------------------------------
-bool FatFile::makeUniqueSfn(FatLfn_t* fname) {
+/**
+ * Form a short name with a ~HHHH tail from a short name with a ~1 tail.
+ *
+ * \param[in] fname Long file name with ~1 short name.
+ * \param[in] hex Value for the four hex digits.
+ * \param[out] sfn Location for the new short name.
+ */
+static void hashSfn(const FatLfn_t* fname, uint16_t hex, uint8_t* sfn) {
+  // Make space in name for ~HHHH.
+  uint8_t pos = fname->seqPos > 3 ? 3 : fname->seqPos;
+  if (sfn != fname->sfn) {
+    memcpy(sfn, fname->sfn, 11);
+  }
+  for (uint8_t i = pos + 4; i > pos; i--) {
+    uint8_t h = hex & 0XF;
+    sfn[i] = h < 10 ? h + '0' : h + 'A' - 10;
+    hex >>= 4;
+  }
+  sfn[pos] = '~';
+}
+//------------------------------------------------------------------------------
+// hex is the ~HHHH value already found in the directory.
+bool FatFile::makeUniqueSfn(FatLfn_t* fname, uint16_t hex) {
   const uint8_t FIRST_HASH_SEQ = 2;  // min value is 2
-  uint8_t pos = fname->seqPos;
   const DirFat_t* dir;
-  uint16_t hex = 0;
 
   DBG_HALT_IF(!(fname->flags & FNAME_FLAG_LOST_CHARS));
-  DBG_HALT_IF(fname->sfn[pos] != '~' && fname->sfn[pos + 1] != '1');
+  DBG_HALT_IF(fname->sfn[fname->seqPos] != '~' &&
+              fname->sfn[fname->seqPos + 1] != '1');
 
   for (uint8_t seq = FIRST_HASH_SEQ; seq < 100; seq++) {
     DBG_WARN_IF(seq > FIRST_HASH_SEQ);
-    hex += millis();
-    if (pos > 3) {
-      // Make space in name for ~HHHH.
-      pos = 3;
-    }
-    for (uint8_t i = pos + 4; i > pos; i--) {
-      uint8_t h = hex & 0XF;
-      fname->sfn[i] = h < 10 ? h + '0' : h + 'A' - 10;
-      hex >>= 4;
-    }
-    fname->sfn[pos] = '~';
+    // An odd step never repeats the previous value.
+    hex += millis() | 1;
+    hashSfn(fname, hex, fname->sfn);
     rewind();
     while (1) {
       dir = readDirCache();
@@ -269,6 +295,7 @@ done:
 //------------------------------------------------------------------------------
 bool FatFile::open(FatFile* dirFile, FatLfn_t* fname, oflag_t oflag) {
   bool fnameFound = false;
+  bool hashFound = false;
   uint8_t lfnOrd = 0;
   uint8_t freeFound = 0;
   uint8_t freeNeed;
@@ -280,9 +307,11 @@ bool FatFile::open(FatFile* dirFile, FatLfn_t* fname, oflag_t oflag) {
   uint16_t date;
   uint16_t freeIndex = 0;
   uint16_t freeTotal;
+  uint16_t hashHex = 0;
   uint16_t time;
   DirFat_t* dir;
   const DirLfn_t* ldir;
+  uint8_t hashName[11];
   auto vol = dirFile->m_vol;
 
   if (!dirFile->isDir() || isOpen()) {
@@ -292,6 +321,12 @@ bool FatFile::open(FatFile* dirFile, FatLfn_t* fname, oflag_t oflag) {
   // Number of directory entries needed.
   nameOrd = (fname->len + 12) / 13;
   freeNeed = (fname->flags & FNAME_FLAG_NEED_LFN) ? 1 + nameOrd : 1;
+  if (fname->flags & FNAME_FLAG_LOST_CHARS) {
+    // Check a ~HHHH name in this pass in case the ~1 name exists.
+    hashHex = millis();
+    hashSfn(fname, hashHex, hashName);
+  }
+  FS_STATS_ADD(&vol->m_stats, dirScans, 1);
   dirFile->rewind();
   while (1) {
     curIndex = dirFile->m_curPosition / FS_DIR_SIZE;
@@ -354,6 +389,9 @@ bool FatFile::open(FatFile* dirFile, FatLfn_t* fname, oflag_t oflag) {
           goto found;
         }
         fnameFound = true;
+      } else if ((fname->flags & FNAME_FLAG_LOST_CHARS) &&
+                 !memcmp(dir->name, hashName, sizeof(hashName))) {
+        hashFound = true;
       }
     } else {
       lfnOrd = 0;
@@ -402,7 +440,10 @@ create:
     freeTotal += vol->dirEntriesPerCluster();
   }
   if (fnameFound) {
-    if (!dirFile->makeUniqueSfn(fname)) {
+    if (!hashFound) {
+      // Avoid another directory scan in makeUniqueSfn().
+      memcpy(fname->sfn, hashName, sizeof(hashName));
+    } else if (!dirFile->makeUniqueSfn(fname, hashHex)) {
       goto fail;
     }
   }
@@ -512,8 +553,8 @@ bool FatFile::remove() {
   DirFat_t* dir;
   DirLfn_t* ldir;
 
-  // Cant' remove not open for write.
-  if (!isWritable()) {
+  // Can't remove if not a file open for write.  Use rmdir() for directories.
+  if (!isFile() || !isWritable()) {
     DBG_FAIL_MACRO;
     goto fail;
   }
@@ -42,6 +42,7 @@ bool FatFile::open(FatFile* dirFile, const FatSfn_t* fname, oflag_t oflag) {
   DirFat_t* dir;
   const DirLfn_t* ldir;
 
+  FS_STATS_ADD(&dirFile->m_vol->m_stats, dirScans, 1);
   dirFile->rewind();
   while (true) {
     dir = dirFile->readDirCache();
@@ -284,8 +285,8 @@ fail:
 //------------------------------------------------------------------------------
 bool FatFile::remove() {
   DirFat_t* dir;
-  // Can't remove if LFN or not open for write.
-  if (!isWritable() || isLFN()) {
+  // Can't remove if LFN or not a file open for write.
+  if (!isFile() || !isWritable() || isLFN()) {
     DBG_FAIL_MACRO;
     goto fail;
   }
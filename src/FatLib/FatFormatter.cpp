@@ -26,12 +26,16 @@
 // Set nonzero to use calculated CHS in MBR.  Should not be required.
 #define USE_LBA_TO_CHS 1
 
+const uint16_t BYTES_PER_SECTOR = FS_SECTOR_SIZE;
 // Constants for file system structure optimized for flash.
-uint16_t const BU16 = 128;
-uint16_t const BU32 = 8192;
-// Assume 512 byte sectors.
-const uint16_t BYTES_PER_SECTOR = 512;
+// Alignment is 64 KiB for FAT16 and 4 MiB for FAT32.
+uint16_t const BU16 = 0X10000 / BYTES_PER_SECTOR;
+uint16_t const BU32 = 0X400000 / BYTES_PER_SECTOR;
 const uint16_t SECTORS_PER_MB = 0X100000 / BYTES_PER_SECTOR;
+// Use FAT32 for volumes of 2 GiB or more.
+const uint32_t FAT32_MIN_SECTORS = 0X400000UL >> (FS_SECTOR_SIZE_SHIFT - 9);
+// Fewer clusters would be FAT12.
+const uint32_t FAT16_MIN_CLUSTERS = 4085;
 const uint16_t FAT16_ROOT_ENTRY_COUNT = 512;
 const uint16_t FAT16_ROOT_SECTOR_COUNT =
     32 * FAT16_ROOT_ENTRY_COUNT / BYTES_PER_SECTOR;
@@ -47,10 +51,12 @@ const uint16_t FAT16_ROOT_SECTOR_COUNT =
   if (m_pr) m_pr->write(str)
 #endif  // PRINT_FORMAT_PROGRESS
 //------------------------------------------------------------------------------
-bool FatFormatter::format(FsBlockDevice* dev, uint8_t* secBuf, print_t* pr) {
+bool FatFormatter::format(FsBlockDevice* dev, uint8_t* secBuf, print_t* pr,
+                          size_t bufSectors) {
   bool rtn;
   m_dev = dev;
   m_secBuf = secBuf;
+  m_bufSectors = bufSectors ? bufSectors : 1;
   m_pr = pr;
   m_sectorCount = m_dev->sectorCount();
   m_capacityMB = (m_sectorCount + SECTORS_PER_MB - 1) / SECTORS_PER_MB;
@@ -74,7 +80,18 @@ bool FatFormatter::format(FsBlockDevice* dev, uint8_t* secBuf, print_t* pr) {
     // SDXC cards
     m_sectorsPerCluster = 128;
   }
-  rtn = m_sectorCount < 0X400000 ? makeFat16() : makeFat32();
+  // Keep the cluster size in bytes for sectors larger than 512 bytes.
+  // The smallest cluster is one sector.
+  m_sectorsPerCluster >>= FS_SECTOR_SIZE_SHIFT - 9;
+  if (m_sectorsPerCluster == 0) {
+    m_sectorsPerCluster = 1;
+  }
+  // FAT16 needs 4085 clusters.  Only possible with large sectors.
+  if (m_sectorCount < FAT16_MIN_CLUSTERS * m_sectorsPerCluster + 2 * BU16) {
+    writeMsg("Card is too small.\r\n");
+    return false;
+  }
+  rtn = m_sectorCount < FAT32_MIN_SECTORS ? makeFat16() : makeFat32();
   if (rtn) {
     writeMsg("Format Done\r\n");
   } else {
@@ -85,17 +102,12 @@ bool FatFormatter::format(FsBlockDevice* dev, uint8_t* secBuf, print_t* pr) {
 //------------------------------------------------------------------------------
 bool FatFormatter::initFatDir(uint8_t fatType, Sector_t sectorCount) {
   size_t n;
-  memset(m_secBuf, 0, BYTES_PER_SECTOR);
   writeMsg("Writing FAT ");
-  for (uint32_t i = 1; i < sectorCount; i++) {
-    if (!m_dev->writeSector(m_fatStart + i, m_secBuf)) {
-      return false;
-    }
-    if ((i % (sectorCount / 32)) == 0) {
-      writeMsg(".");
-    }
+  if (!writeZeros(m_fatStart + 1, sectorCount - 1)) {
+    return false;
   }
   writeMsg("\r\n");
+  memset(m_secBuf, 0, BYTES_PER_SECTOR);
   // Allocate reserved clusters and root for FAT32.
   m_secBuf[0] = 0XF8;
   n = fatType == 16 ? 4 : 12;
@@ -145,14 +157,15 @@ bool FatFormatter::makeFat16() {
     }
   }
   // check valid cluster count for FAT16 volume
-  if (nc < 4085 || nc >= 65525) {
+  if (nc < FAT16_MIN_CLUSTERS || nc >= 65525) {
     writeMsg("Bad cluster count\r\n");
     return false;
   }
   m_reservedSectorCount = 1;
   m_fatStart = m_startSector + m_reservedSectorCount;
   m_totalSectors =
-      nc * m_sectorsPerCluster + 2 * m_fatSize + m_reservedSectorCount + 32;
+      nc * m_sectorsPerCluster + 2 * m_fatSize + m_reservedSectorCount +
+      FAT16_ROOT_SECTOR_COUNT;
   if (m_totalSectors < 65536) {
     m_partType = 0X04;
   } else {
@@ -278,3 +291,27 @@ bool FatFormatter::writeMbr() {
   setLe16(mbr->signature, MBR_SIGNATURE);
   return m_dev->writeSector(0, m_secBuf);
 }
+//------------------------------------------------------------------------------
+bool FatFormatter::writeZeros(Sector_t sector, uint32_t count) {
+  uint32_t dotStep = count / 32 ? count / 32 : 1;
+  uint32_t nextDot = dotStep;
+  uint32_t done = 0;
+  if (count == 0 || m_dev->zeroSectors(sector, sector + count - 1)) {
+    return true;
+  }
+  memset(m_secBuf, 0, m_bufSectors * BYTES_PER_SECTOR);
+  while (done < count) {
+    uint32_t n = count - done;
+    if (n > m_bufSectors) {
+      n = m_bufSectors;
+    }
+    if (!m_dev->writeSectors(sector + done, m_secBuf, n)) {
+      return false;
+    }
+    done += n;
+    for (; nextDot <= done; nextDot += dotStep) {
+      writeMsg(".");
+    }
+  }
+  return true;
+}
@@ -39,10 +39,13 @@ class FatFormatter {
    * \param[in] dev Block device for volume.
    * \param[in] secBuffer buffer for writing to volume.
    * \param[in] pr Print device for progress output.
+   * \param[in] bufSectors Size of secBuf in sectors.  A larger buffer
+   * allows fewer, larger writes when zeroing the FAT and directories.
    *
    * \return true for success or false for failure.
    */
-  bool format(FsBlockDevice* dev, uint8_t* secBuffer, print_t* pr = nullptr);
+  bool format(FsBlockDevice* dev, uint8_t* secBuffer, print_t* pr = nullptr,
+              size_t bufSectors = 1);
 
  private:
   bool initFatDir(uint8_t fatType, Sector_t sectorCount);
@@ -50,6 +53,7 @@ class FatFormatter {
   bool makeFat16();
   bool makeFat32();
   bool writeMbr();
+  bool writeZeros(Sector_t sector, uint32_t count);
   uint32_t m_capacityMB;
   uint32_t m_dataStart;
   uint32_t m_fatSize;
@@ -60,6 +64,7 @@ class FatFormatter {
   FsBlockDevice* m_dev;
   print_t* m_pr;
   uint8_t* m_secBuf;
+  size_t m_bufSectors;
   uint16_t m_reservedSectorCount;
   uint8_t m_partType;
   uint8_t m_sectorsPerCluster;
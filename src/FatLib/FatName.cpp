@@ -127,6 +127,20 @@ size_t FatFile::getName8(char* name, size_t size) {
       goto fail;
     }
     for (uint8_t i = 0; i < 13; i++) {
+      if (!hs && (i == 0 || i == 5 || i == 11)) {
+        // Copy a run of ASCII characters.  Save space for zero byte.
+        const uint8_t* u16 = i == 0   ? ldir->unicode1
+                             : i == 5 ? ldir->unicode2
+                                      : ldir->unicode3;
+        uint8_t len = i == 0 ? 5 : i == 5 ? 6 : 2;
+        uint8_t n = FsUtf::u16ToAscii(u16, len, str, end - 1);
+        str += n;
+        if (n == len) {
+          i += n - 1;
+          continue;
+        }
+        i += n;
+      }
       uint16_t c = getLfnChar(ldir, i);
       if (hs) {
         if (!FsUtf::isLowSurrogate(c)) {
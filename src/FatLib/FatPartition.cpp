@@ -80,6 +80,7 @@ bool FatPartition::allocateCluster(Cluster_t current, Cluster_t* next) {
       goto fail;
     }
   }
+  discardCancel(find, 1);
   updateFreeClusterCount(-1);
   *next = find;
   return true;
@@ -89,7 +90,8 @@ fail:
 }
 //------------------------------------------------------------------------------
 // find a contiguous group of clusters
-bool FatPartition::allocContiguous(uint32_t count, Cluster_t* firstCluster) {
+bool FatPartition::allocContiguous(uint32_t count, Cluster_t* firstCluster,
+                                   Sector_t align) {
   // flag to save place to start next search
   bool setStart = true;
   // start of group
@@ -106,6 +108,13 @@ bool FatPartition::allocContiguous(uint32_t count, Cluster_t* firstCluster) {
       DBG_FAIL_MACRO;
       goto fail;
     }
+    if (align && bgnCluster == endCluster &&
+        clusterStartSector(endCluster) % align) {
+      // Group must start at a boundary.
+      setStart = false;
+      bgnCluster = ++endCluster;
+      continue;
+    }
     uint32_t f;
     int8_t fg = fatGet(endCluster, &f);
     if (fg < 0) {
@@ -142,6 +151,7 @@ bool FatPartition::allocContiguous(uint32_t count, Cluster_t* firstCluster) {
     }
     endCluster--;
   }
+  discardCancel(bgnCluster, count);
   // Maintain count of free clusters.
   updateFreeClusterCount(-count);
 
@@ -158,6 +168,7 @@ int8_t FatPartition::fatGet(Cluster_t cluster, Cluster_t* value) {
   Sector_t sector;
   uint32_t next;
   const uint8_t* pc;
+  FS_STATS_ADD(&m_stats, fatGets, 1);
 
   // error if reserved cluster of beyond FAT
   if (cluster < 2 || cluster > m_lastCluster) {
@@ -224,6 +235,7 @@ fail:
 bool FatPartition::fatPut(Cluster_t cluster, Cluster_t value) {
   Sector_t sector;
   uint8_t* pc;
+  FS_STATS_ADD(&m_stats, fatPuts, 1);
 
   // error if reserved cluster of beyond FAT
   if (cluster < 2 || cluster > m_lastCluster) {
@@ -301,6 +313,7 @@ fail:
 bool FatPartition::freeChain(Cluster_t cluster) {
   uint32_t next;
   int8_t fg;
+  Cluster_t start = cluster;
   do {
     fg = fatGet(cluster, &next);
     if (fg < 0) {
@@ -317,6 +330,10 @@ bool FatPartition::freeChain(Cluster_t cluster) {
     if (cluster < m_allocSearchStart) {
       m_allocSearchStart = cluster - 1;
     }
+    if (fg == 0 || (cluster + 1) != next) {
+      discardAdd(start, cluster - start + 1);
+      start = next;
+    }
     cluster = next;
   } while (fg);
 
@@ -402,9 +419,19 @@ bool FatPartition::init(FsBlockDevice* dev, uint8_t part,
   m_fatType = 0;
   m_allocSearchStart = 1;
   m_cache.init(dev);
+#if USE_DISCARD_FREE_CLUSTERS
+  m_discard.init(dev->allocationUnitSectors());
+#endif  // USE_DISCARD_FREE_CLUSTERS
 #if USE_SEPARATE_FAT_CACHE
   m_fatCache.init(dev);
 #endif  // USE_SEPARATE_FAT_CACHE
+#if USE_FS_STATS
+  m_stats.clear();
+  m_cache.setStats(&m_stats);
+#if USE_SEPARATE_FAT_CACHE
+  m_fatCache.setStats(&m_stats);
+#endif  // USE_SEPARATE_FAT_CACHE
+#endif  // USE_FS_STATS
   // if part == 0 assume super floppy with FAT boot sector in sector zero
   // if part > 0 assume mbr volume with partition table
   if (part) {
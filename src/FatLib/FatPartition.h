@@ -31,6 +31,7 @@
 
 #include "../common/FsBlockDevice.h"
 #include "../common/FsCache.h"
+#include "../common/FsDiscard.h"
 #include "../common/FsStructs.h"
 #include "../common/SysCall.h"
 
@@ -59,8 +60,8 @@ class FatPartition {
     return m_sectorsPerClusterShift + m_bytesPerSectorShift;
   }
   /** \return Number of bytes in a cluster. */
-  uint16_t bytesPerCluster() const {
-    return m_bytesPerSector << m_sectorsPerClusterShift;
+  uint32_t bytesPerCluster() const {
+    return static_cast<uint32_t>(m_bytesPerSector) << m_sectorsPerClusterShift;
   }
   /** \return Number of bytes per sector. */
   uint16_t bytesPerSector() const { return m_bytesPerSector; }
@@ -135,6 +136,12 @@ class FatPartition {
    * \return true if busy else false.
    */
   bool isBusy() { return m_blockDev->isBusy(); }
+#if USE_FS_STATS
+  /** Set the operation counters to zero. */
+  void clearStats() { m_stats.clear(); }
+  /** \return A snapshot of the operation counters. */
+  FsStats stats() const { return m_stats; }
+#endif  // USE_FS_STATS
   //----------------------------------------------------------------------------
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
   bool dmpDirSector(print_t* pr, Sector_t sector);
@@ -147,7 +154,7 @@ class FatPartition {
   /** FatFile allowed access to private members. */
   friend class FatFile;
   //----------------------------------------------------------------------------
-  static const uint8_t m_bytesPerSectorShift = 9;
+  static const uint8_t m_bytesPerSectorShift = FS_SECTOR_SIZE_SHIFT;
   static const uint16_t m_bytesPerSector = 1 << m_bytesPerSectorShift;
   static const uint16_t m_sectorMask = m_bytesPerSector - 1;
   //----------------------------------------------------------------------------
@@ -164,6 +171,9 @@ class FatPartition {
   Sector_t m_fatStartSector;         // Start sector for first FAT.
   Cluster_t m_lastCluster;           // Last cluster number in FAT.
   Cluster_t m_rootDirStart;          // Start sector FAT16, cluster FAT32.
+#if USE_FS_STATS
+  FsStats m_stats;  // Operation counters.
+#endif              // USE_FS_STATS
   //----------------------------------------------------------------------------
   // sector I/O functions.
   bool cacheSafeRead(Sector_t sector, uint8_t* dst) {
@@ -178,6 +188,10 @@ class FatPartition {
   bool cacheSafeWrite(Sector_t sector, const uint8_t* dst, size_t count) {
     return m_cache.cacheSafeWrite(sector, dst, count);
   }
+  bool cacheSafeWrite(Sector_t sector, const uint8_t* dst, size_t count,
+                      uint32_t eraseCount) {
+    return m_cache.cacheSafeWrite(sector, dst, count, eraseCount);
+  }
   bool syncDevice() { return m_blockDev->syncDevice(); }
 #if MAINTAIN_FREE_CLUSTER_COUNT
   int32_t m_freeClusterCount;  // Count of free clusters in volume.
@@ -191,6 +205,29 @@ class FatPartition {
   void setFreeClusterCount(int32_t value) { (void)value; }
   void updateFreeClusterCount(int32_t change) { (void)change; }
 #endif  // MAINTAIN_FREE_CLUSTER_COUNT
+#if USE_DISCARD_FREE_CLUSTERS
+  FsDiscard m_discard;
+  void discardAdd(Cluster_t cluster, uint32_t count) {
+    m_discard.add(cluster, count);
+  }
+  void discardCancel(Cluster_t cluster, uint32_t count) {
+    m_discard.cancel(cluster, count);
+  }
+  bool discardFlush() {
+    return m_discard.flush(m_blockDev, m_dataStartSector,
+                           m_sectorsPerClusterShift);
+  }
+#else   // USE_DISCARD_FREE_CLUSTERS
+  void discardAdd(Cluster_t cluster, uint32_t count) {
+    (void)cluster;
+    (void)count;
+  }
+  void discardCancel(Cluster_t cluster, uint32_t count) {
+    (void)cluster;
+    (void)count;
+  }
+  bool discardFlush() { return true; }
+#endif  // USE_DISCARD_FREE_CLUSTERS
         // sector caches
   FsCache m_cache;
   FsCache* dataCache() { return &m_cache; }
@@ -203,7 +240,8 @@ class FatPartition {
     return m_fatCache.prepare(sector, options);
   }
   bool cacheSync() {
-    return m_cache.sync() && m_fatCache.sync() && syncDevice();
+    return m_cache.sync() && m_fatCache.sync() && syncDevice() &&
+           discardFlush();
   }
 #else   // USE_SEPARATE_FAT_CACHE
   uint8_t* fatCachePrepare(Sector_t sector, uint8_t options) {
@@ -212,7 +250,9 @@ class FatPartition {
     }
     return dataCachePrepare(sector, options);
   }
-  bool cacheSync() { return m_cache.sync() && syncDevice(); }
+  bool cacheSync() {
+    return m_cache.sync() && syncDevice() && discardFlush();
+  }
 #endif  // USE_SEPARATE_FAT_CACHE
   uint8_t* dataCachePrepare(Sector_t sector, uint8_t options) {
     return m_cache.prepare(sector, options);
@@ -223,9 +263,13 @@ class FatPartition {
   void cacheDirty() { m_cache.dirty(); }
   //----------------------------------------------------------------------------
   bool allocateCluster(Cluster_t current, Cluster_t* next);
-  bool allocContiguous(uint32_t count, Cluster_t* firstCluster);
+  bool allocContiguous(uint32_t count, Cluster_t* firstCluster,
+                       Sector_t align = 0);
+  Sector_t allocationUnitSectors() {
+    return m_blockDev->allocationUnitSectors();
+  }
   uint8_t sectorOfCluster(uint32_t position) const {
-    return (position >> 9) & m_clusterSectorMask;
+    return (position >> m_bytesPerSectorShift) & m_clusterSectorMask;
   }
   Cluster_t clusterStartSector(Cluster_t cluster) const {
     return m_dataStartSector + ((cluster - 2) << m_sectorsPerClusterShift);
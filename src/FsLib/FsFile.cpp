@@ -223,3 +223,32 @@ bool FsBaseFile::rmdir() {
   }
   return false;
 }
+//------------------------------------------------------------------------------
+// Callback and context for walk().
+struct FsWalkContext_t {
+  FsWalkCallback_t callback;
+  void* context;
+};
+//------------------------------------------------------------------------------
+bool FsBaseFile::walk(FsWalkCallback_t callback, void* context) {
+  FsWalkContext_t ctx = {callback, context};
+  return m_fFile   ? m_fFile->walk(walkFat, &ctx)
+         : m_xFile ? m_xFile->walk(walkExFat, &ctx)
+                   : false;
+}
+//------------------------------------------------------------------------------
+uint8_t FsBaseFile::walkExFat(ExFatFile* file, uint8_t depth, void* context) {
+  FsWalkContext_t* ctx = reinterpret_cast<FsWalkContext_t*>(context);
+  FsBaseFile tmp;
+  tmp.m_xFile = new (tmp.m_fileMem) ExFatFile;
+  tmp.m_xFile->copy(file);
+  return ctx->callback(&tmp, depth, ctx->context);
+}
+//------------------------------------------------------------------------------
+uint8_t FsBaseFile::walkFat(FatFile* file, uint8_t depth, void* context) {
+  FsWalkContext_t* ctx = reinterpret_cast<FsWalkContext_t*>(context);
+  FsBaseFile tmp;
+  tmp.m_fFile = new (tmp.m_fileMem) FatFile;
+  tmp.m_fFile->copy(file);
+  return ctx->callback(&tmp, depth, ctx->context);
+}
@@ -31,6 +31,10 @@
 #include "FatLib/FatLib.h"
 #include "FsNew.h"
 #include "FsVolume.h"
+class FsBaseFile;
+/** Callback for FsBaseFile::walk(). */
+typedef uint8_t (*FsWalkCallback_t)(FsBaseFile* file, uint8_t depth,
+                                    void* context);
 /**
  * \class FsBaseFile
  * \brief FsBaseFile class.
@@ -158,6 +162,18 @@ class FsBaseFile {
    * \return true for success or false for failure.
    */
   bool close();
+  /** Compact a directory.
+   *
+   * \note Files and subdirectories in the directory must be closed since
+   * their directory entries may be moved.
+   *
+   * \return true for success or false for failure.
+   */
+  bool compact() {
+    return m_fFile   ? m_fFile->compact()
+           : m_xFile ? m_xFile->compact()
+                     : false;
+  }
   /** Check for contiguous file and return its raw sector range.
    *
    * \param[out] bgnSector the first sector address for the file.
@@ -586,11 +602,15 @@ class FsBaseFile {
    * the requested length.
    *
    * \param[in] length size of the file in bytes.
+   * \param[in] alignAu Start the file at an allocation unit boundary
+   * of the card if free space is available.  Streaming writes to whole
+   * allocation units are faster on most cards.
    * \return true for success or false for failure.
    */
-  bool preAllocate(uint64_t length) {
-    return m_fFile   ? length < (1ULL << 32) && m_fFile->preAllocate(length)
-           : m_xFile ? m_xFile->preAllocate(length)
+  bool preAllocate(uint64_t length, bool alignAu = false) {
+    return m_fFile ? length < (1ULL << 32) &&
+                         m_fFile->preAllocate(length, alignAu)
+           : m_xFile ? m_xFile->preAllocate(length, alignAu)
                      : false;
   }
   /** Print a file's access date and time
@@ -806,6 +826,24 @@ class FsBaseFile {
    *
    * \return true for success or false for failure.
    */
+#if USE_FS_FILE_STATS
+  /** Set the operation counters for this file to zero. */
+  void clearStats() {
+    if (m_fFile) {
+      m_fFile->clearStats();
+    } else if (m_xFile) {
+      m_xFile->clearStats();
+    }
+  }
+  /** \return A snapshot of the volume counts caused by read(), write()
+   * and sync() calls since this file was opened or clearStats() was called.
+   */
+  FsStats stats() const {
+    return m_fFile   ? m_fFile->stats()
+           : m_xFile ? m_xFile->stats()
+                     : FsStats();
+  }
+#endif  // USE_FS_FILE_STATS
   bool sync() {
     return m_fFile ? m_fFile->sync() : m_xFile ? m_xFile->sync() : false;
   }
@@ -874,6 +912,27 @@ class FsBaseFile {
   uint64_t validLength() const {
     return m_fFile ? m_fFile->fileSize() : m_xFile ? m_xFile->validLength() : 0;
   }
+  /** Walk the tree below this directory.
+   *
+   * Entries are visited in directory order and a subdirectory is visited
+   * before its contents.  The walk is iterative and streams through each
+   * directory once.  Ancestors are saved in a stack of WALK_MAX_DEPTH
+   * frames so no path lookups are done.  Each entry is opened from the
+   * cached directory sector and a parent resumes at its saved cluster.
+   *
+   * \param[in] callback Called for each entry with the open entry, the
+   * depth of the entry below this directory, and \a context.  The callback
+   * returns WALK_CONTINUE, WALK_SKIP to not descend into a subdirectory,
+   * or WALK_STOP to end the walk.
+   * \param[in] context Passed to \a callback.
+   *
+   * \note The entry is closed when the callback returns.  Files must not
+   * be created or removed during the walk.
+   *
+   * \return true for success or false for failure.  The walk fails if
+   * the tree is deeper than WALK_MAX_DEPTH.
+   */
+  bool walk(FsWalkCallback_t callback, void* context = nullptr);
   /** Write a string to a file. Used by the Arduino Print class.
    * \param[in] str Pointer to the string.
    * Use getWriteError to check for errors.
@@ -905,6 +964,8 @@ class FsBaseFile {
   }
 
  private:
+  static uint8_t walkExFat(ExFatFile* file, uint8_t depth, void* context);
+  static uint8_t walkFat(FatFile* file, uint8_t depth, void* context);
   newalign_t m_fileMem[FS_ALIGN_DIM(ExFatFile, FatFile)];
   FatFile* m_fFile = nullptr;
   ExFatFile* m_xFile = nullptr;
@@ -39,16 +39,21 @@ class FsFormatter {
    * \param[in] dev Block device for volume.
    * \param[in] secBuffer buffer for writing to volume.
    * \param[in] pr Print device for progress output.
+   * \param[in] bufSectors Size of secBuf in sectors.  A larger buffer
+   * allows fewer, larger writes when zeroing the FAT and directories.
    *
    * \return true for success or false for failure.
    */
-  bool format(FsBlockDevice* dev, uint8_t* secBuffer, print_t* pr = nullptr) {
+  bool format(FsBlockDevice* dev, uint8_t* secBuffer, print_t* pr = nullptr,
+              size_t bufSectors = 1) {
     Sector_t sectorCount = dev->sectorCount();
     if (sectorCount == 0) {
       return false;
     }
-    return sectorCount <= 67108864 ? m_fFmt.format(dev, secBuffer, pr)
-                                   : m_xFmt.format(dev, secBuffer, pr);
+    // Use exFAT for volumes larger than 32 GiB.
+    return sectorCount <= (67108864 >> (FS_SECTOR_SIZE_SHIFT - 9))
+               ? m_fFmt.format(dev, secBuffer, pr, bufSectors)
+               : m_xFmt.format(dev, secBuffer, pr, bufSectors);
   }
 
  private:
@@ -120,7 +120,7 @@ class FsVolume {
   uint8_t* end() {
     m_fVol = nullptr;
     m_xVol = nullptr;
-    static_assert(sizeof(m_volMem) >= 512, "m_volMem too small");
+    static_assert(sizeof(m_volMem) >= FS_SECTOR_SIZE, "m_volMem too small");
     return reinterpret_cast<uint8_t*>(m_volMem);
   }
   //----------------------------------------------------------------------------
@@ -170,6 +170,23 @@ class FsVolume {
   bool isBusy() {
     return m_fVol ? m_fVol->isBusy() : m_xVol ? m_xVol->isBusy() : false;
   }
+#if USE_FS_STATS
+  //----------------------------------------------------------------------------
+  /** Set the operation counters to zero. */
+  void clearStats() {
+    if (m_fVol) {
+      m_fVol->clearStats();
+    } else if (m_xVol) {
+      m_xVol->clearStats();
+    }
+  }
+  /** \return A snapshot of the operation counters. */
+  FsStats stats() const {
+    return m_fVol   ? m_fVol->stats()
+           : m_xVol ? m_xVol->stats()
+                    : FsStats();
+  }
+#endif  // USE_FS_STATS
   //----------------------------------------------------------------------------
   /** List directory contents.
    *
@@ -27,6 +27,7 @@
 
 #include <algorithm>  // Required for std::max, std::min
 #define DEBUG_FILE "PioSdioCard.cpp"
+#include "../SdBusy.h"
 #include "../SdCardInfo.h"
 #include "DbgLog.h"
 #include "PioSdioCard.h"
@@ -61,6 +62,7 @@ static const CmdRsp_t CMD38_R1(CMD38, RSP_R1);
 static const CmdRsp_t CMD55_R1(CMD55, RSP_R1);
 static const CmdRsp_t ACMD6_R1(ACMD6, RSP_R1);
 static const CmdRsp_t ACMD13_R1(ACMD13, RSP_R1);
+static const CmdRsp_t ACMD23_R1(ACMD23, RSP_R1);
 static const CmdRsp_t ACMD41_R3(ACMD41, RSP_R3);
 static const CmdRsp_t ACMD51_R1(ACMD51, RSP_R1);
 //==============================================================================
@@ -450,6 +452,7 @@ void PioSdioCard::end() { pioEnd(); }
 //------------------------------------------------------------------------------
 bool PioSdioCard::erase(uint32_t firstSector, uint32_t lastSector) {
   Timeout timeout(SD_ERASE_TIMEOUT);
+  SdBusyWait busyWait(SD_BUSY_STATS);
   if (!syncDevice()) {
     SDIO_FAIL();
     goto fail;
@@ -485,6 +488,7 @@ bool PioSdioCard::erase(uint32_t firstSector, uint32_t lastSector) {
       sdError(SD_CARD_ERROR_ERASE_TIMEOUT);
       goto fail;
     }
+    busyWait.poll();
   }
   return true;
 fail:
@@ -497,6 +501,10 @@ uint32_t PioSdioCard::errorData() const { return m_cardRsp; }
 //------------------------------------------------------------------------------
 uint32_t PioSdioCard::errorLine() const { return m_errorLine; }
 //------------------------------------------------------------------------------
+#if SD_LATENCY_STATS
+SdLatencyStats* PioSdioCard::latencyStats() { return &m_latencyStats; }
+#endif  // SD_LATENCY_STATS
+//------------------------------------------------------------------------------
 bool PioSdioCard::isBusy() {
   return gpio_get(m_dat0Pin) ? false : !(status() & CARD_STATUS_READY_FOR_DATA);
 }
@@ -778,6 +786,7 @@ bool PioSdioCard::readSDS(sds_t* sds) {
 }
 //------------------------------------------------------------------------------
 bool PioSdioCard::readSector(Sector_t sector, uint8_t* dst) {
+  SD_LATENCY_TIMER(SdLatencyStats::READ_SINGLE);
   if (m_curState != READ_STATE || sector != m_curSector) {
     if (!syncDevice()) {
       SDIO_FAIL();
@@ -802,6 +811,8 @@ fail:
 }
 //------------------------------------------------------------------------------
 bool PioSdioCard::readSectors(Sector_t sector, uint8_t* dst, size_t ns) {
+  SD_LATENCY_TIMER(ns == 1 ? SdLatencyStats::READ_SINGLE
+                           : SdLatencyStats::READ_MULTI);
   for (size_t i = 0; i < ns; i++) {
     if (!readSector(sector + i, dst + i * 512UL)) {
       SDIO_FAIL();
@@ -842,12 +853,15 @@ Sector_t PioSdioCard::sectorCount() { return m_csd.capacity(); }
 //------------------------------------------------------------------------------
 bool PioSdioCard::syncDevice() {
   if (m_curState != IDLE_STATE) {
+    SD_LATENCY_TIMER(SdLatencyStats::SYNC);
     Timeout timeout(SD_INIT_TIMEOUT);
+    SdBusyWait busyWait(SD_BUSY_STATS);
     while (!gpio_get(m_dat0Pin)) {
       if (timeout.timedOut()) {
         sdError(SD_CARD_ERROR_CMD12);
         goto fail;
       }
+      busyWait.poll();
     }
     if (!cardCommand(CMD12_R1, 0)) {
       sdError(SD_CARD_ERROR_CMD12);
@@ -858,6 +872,7 @@ bool PioSdioCard::syncDevice() {
         sdError(SD_CARD_ERROR_CMD12);
         goto fail;
       }
+      busyWait.poll();
     }
     m_curState = IDLE_STATE;
   }
@@ -875,16 +890,24 @@ uint8_t PioSdioCard::type() const {
 }
 //------------------------------------------------------------------------------
 bool PioSdioCard::writeSector(Sector_t sector, const uint8_t* src) {
+  SD_LATENCY_TIMER(SdLatencyStats::WRITE_SINGLE);
   return writeSectors(sector, src, 1);
 }
 //------------------------------------------------------------------------------
 bool PioSdioCard::writeSectors(Sector_t sector, const uint8_t* src, size_t ns) {
+  return writeSectorsPreErase(sector, src, ns, 0);
+}
+//------------------------------------------------------------------------------
+bool PioSdioCard::writeSectorsPreErase(Sector_t sector, const uint8_t* src,
+                                       size_t ns, uint32_t eraseCount) {
+  SD_LATENCY_TIMER(ns == 1 ? SdLatencyStats::WRITE_SINGLE
+                           : SdLatencyStats::WRITE_MULTI);
   if (m_curState != WRITE_STATE || m_curSector != sector) {
     if (!syncDevice()) {
       SDIO_FAIL();
       goto fail;
     }
-    if (!writeStart(sector)) {
+    if (!writeStart(sector, eraseCount)) {
       sdError(SD_CARD_ERROR_WRITE_START);
       goto fail;
     }
@@ -920,11 +943,13 @@ bool __time_critical_func(PioSdioCard::writeData)(const uint8_t* src) {
   uint64_t crc = 0;
 
   Timeout timeout(SD_WRITE_TIMEOUT);
+  SdBusyWait busyWait(SD_BUSY_STATS);
   while (!gpio_get(m_dat0Pin)) {
     if (timeout.timedOut()) {
       sdError(SD_CARD_ERROR_WRITE_TIMEOUT);
       goto fail;
     }
+    busyWait.poll();
   }
   pio_sm_init(m_pio, m_sm0, m_wrDataOffset, &m_wrDataConfig);
   pio_sm_init(m_pio, m_sm1, m_wrRespOffset, &m_wrRespConfig);
@@ -983,8 +1008,18 @@ fail:
   return false;
 }
 //------------------------------------------------------------------------------
-bool PioSdioCard::writeStart(Sector_t sector) {
+bool PioSdioCard::writeStart(Sector_t sector) { return writeStart(sector, 0); }
+//------------------------------------------------------------------------------
+bool PioSdioCard::writeStart(Sector_t sector, uint32_t eraseCount) {
   uint arg = m_highCapacity ? sector : 512 * sector;
+  // ACMD23 count is 23 bits.
+  if (eraseCount > 0X7FFFFF) {
+    eraseCount = 0X7FFFFF;
+  }
+  if (eraseCount > 1 && !cardAcmd(m_rca, ACMD23_R1, eraseCount)) {
+    sdError(SD_CARD_ERROR_ACMD23);
+    goto fail;
+  }
   if (!cardCommand(CMD25_R1, arg)) {
     sdError(SD_CARD_ERROR_CMD25);
     goto fail;
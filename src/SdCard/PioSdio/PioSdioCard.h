@@ -148,6 +148,10 @@ class PioSdioCard : public SdCardInterface {
   bool isBusy() final;
   /** \return the SD clock frequency in kHz. */
   uint32_t kHzSdClk();
+#if SD_LATENCY_STATS
+  /** \return Command latency histograms. */
+  SdLatencyStats* latencyStats() final;
+#endif  // SD_LATENCY_STATS
   /**
    * Read a 512 byte sector from an SD card.
    *
@@ -263,6 +267,19 @@ class PioSdioCard : public SdCardInterface {
    * \return true for success or false for failure.
    */
   bool writeSectors(Sector_t sector, const uint8_t* src, size_t ns) final;
+  /**
+   * Write multiple 512 byte sectors with a hint for pre-erase.
+   *
+   * \param[in] sector Logical sector to be written.
+   * \param[in] src Pointer to the location of the data to be written.
+   * \param[in] ns Number of sectors to be written.
+   * \param[in] eraseCount Number of sectors, starting at sector, that will
+   * be written by this and following sequential writes.
+   *
+   * \return true for success or false for failure.
+   */
+  bool writeSectorsPreErase(Sector_t sector, const uint8_t* src, size_t ns,
+                            uint32_t eraseCount) final;
   /** Write one data sector in a multiple sector write sequence.
    * \param[in] src Pointer to the location of the data to be written.
    * \return true for success or false for failure.
@@ -278,6 +295,17 @@ class PioSdioCard : public SdCardInterface {
    * \return true for success or false for failure.
    */
   bool writeStart(Sector_t sector);
+  /** Start a write multiple sectors sequence with pre-erase.
+   *
+   * \param[in] sector Address of first sector in sequence.
+   * \param[in] eraseCount The number of sectors to be pre-erased.
+   *
+   * \note ACMD23 is sent before CMD25 if eraseCount is greater than one.
+   * Sectors that are pre-erased but not written have undefined content.
+   *
+   * \return true for success or false for failure.
+   */
+  bool writeStart(Sector_t sector, uint32_t eraseCount);
 
   /** End a write multiple sectors sequence.
    *
@@ -315,6 +343,9 @@ class PioSdioCard : public SdCardInterface {
   csd_t m_csd;
   scr_t m_scr;
   sds_t m_sds;
+#if SD_LATENCY_STATS
+  SdLatencyStats m_latencyStats;
+#endif  // SD_LATENCY_STATS
 
   float m_clkDiv = 0;
   uint m_clkPin = 63u;   // PIN_SDIO_UNDEFINED;
@@ -0,0 +1,119 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * \file
+ * \brief Callback for SD card busy time.
+ */
+#pragma once
+#include "../common/SysCall.h"
+#include "SdLatencyStats.h"
+/** Busy callback */
+namespace SdBusy {
+/** Yield callback. */
+extern void (*yieldCallback)();
+/** Sleep callback. */
+extern void (*sleepCallback)(uint16_t ms);
+/** Cancel callbacks. */
+void clearCallback();
+/** Set the busy callback function.
+ *
+ * \param[in] yieldFcn The user's callback function.  The callback is
+ * called for each poll of a busy card and should return quickly.
+ *
+ * \code
+ * void sdYield() {
+ *   // Service sensors, network or other tasks here.
+ * }
+ * \endcode
+ */
+void setCallback(void (*yieldFcn)());
+/** Set the sleep callback function.
+ *
+ * \param[in] sleepFcn The user's callback function.  The callback is
+ * called with a suggested sleep time in ms.  The time starts at zero
+ * and doubles for each poll of a busy card up to SD_BUSY_MAX_SLEEP_MS.
+ * It is used for program, erase and initialization busy waits.  Waits
+ * for SPI read data and SDIO DMA transfers only call the yield callback.
+ *
+ * \code
+ * // FreeRTOS example.
+ * void sdSleep(uint16_t ms) {
+ *   vTaskDelay(ms ? pdMS_TO_TICKS(ms) : 0);
+ * }
+ * \endcode
+ */
+void setSleepCallback(void (*sleepFcn)(uint16_t ms));
+}  // namespace SdBusy
+//------------------------------------------------------------------------------
+/**
+ * \class SdBusyWait
+ * \brief State for one busy wait loop.
+ */
+class SdBusyWait {
+ public:
+  /** Constructor.
+   * \param[in] stats Histograms for busy time or nullptr.
+   */
+  explicit SdBusyWait(SdLatencyStats* stats = nullptr) {
+#if SD_LATENCY_STATS
+    m_stats = stats;
+    m_start = stats ? micros() : 0;
+#else   // SD_LATENCY_STATS
+    (void)stats;
+#endif  // SD_LATENCY_STATS
+  }
+#if SD_LATENCY_STATS
+  ~SdBusyWait() {
+    if (m_stats && m_busy) {
+      m_stats->record(SdLatencyStats::BUSY, micros() - m_start);
+    }
+  }
+#endif  // SD_LATENCY_STATS
+  /** Call for each poll that finds the card busy. */
+  void poll() {
+#if SD_LATENCY_STATS
+    m_busy = true;
+#endif  // SD_LATENCY_STATS
+#if USE_SD_BUSY_CALLBACK
+    if (SdBusy::sleepCallback) {
+      SdBusy::sleepCallback(m_sleepMs);
+      m_sleepMs = m_sleepMs ? 2 * m_sleepMs : 1;
+      if (m_sleepMs > SD_BUSY_MAX_SLEEP_MS) {
+        m_sleepMs = SD_BUSY_MAX_SLEEP_MS;
+      }
+    } else if (SdBusy::yieldCallback) {
+      SdBusy::yieldCallback();
+    }
+#endif  // USE_SD_BUSY_CALLBACK
+  }
+
+ private:
+#if SD_LATENCY_STATS
+  SdLatencyStats* m_stats;
+  uint32_t m_start;
+  bool m_busy = false;
+#endif  // SD_LATENCY_STATS
+  uint16_t m_sleepMs = 0;
+};
@@ -27,6 +27,7 @@
  * \brief Top level include for SPI and SDIO cards.
  */
 #pragma once
+#include "SdBusy.h"
 #include "SdSpiCard/SdSpiCard.h"
 #if defined(HAS_PIO_SDIO)
 #include "PioSdio/PioSdioCard.h"
@@ -271,6 +271,8 @@ const uint8_t WRITE_MULTIPLE_TOKEN = 0XFC;
 const uint8_t DATA_RES_MASK = 0X1F;
 /** write data accepted token */
 const uint8_t DATA_RES_ACCEPTED = 0X05;
+/** write data rejected due to a CRC error */
+const uint8_t DATA_RES_CRC_ERROR = 0X0B;
 //==============================================================================
 /**
  * \class cid_t
@@ -346,6 +348,8 @@ struct csd_t {
   bool eraseSingleBlock() const { return csd[10] & 0X40; }
   /** \return erase size in 512 byte blocks if eraseSingleBlock is false. */
   int eraseSize() const { return ((csd[10] & 0X3F) << 1 | csd[11] >> 7) + 1; }
+  /** \return erase granularity in 512 byte blocks. */
+  uint8_t eraseSectors() const { return eraseSingleBlock() ? 1 : eraseSize(); }
   /** \return true if the contents is copied or true if original. */
   bool copy() const { return csd[14] & 0X40; }
   /** \return true if the entire card is permanently write protected. */
@@ -353,6 +357,28 @@ struct csd_t {
   /** \return true if the entire card is temporarily write protected. */
   bool tempWriteProtect() const { return csd[14] & 0X10; }
 };
+/** Shrink a sector range to whole erase groups.
+ *
+ * \param[in] eraseSectors Erase group size from csd_t::eraseSectors().
+ * \param[in,out] first First sector of the range.
+ * \param[in,out] last Last sector of the range.
+ *
+ * \return false if the range contains no whole erase group.
+ */
+inline bool sdEraseAlign(uint8_t eraseSectors, Sector_t* first,
+                         Sector_t* last) {
+  if (eraseSectors > 1) {
+    // erase size mask
+    Sector_t m = eraseSectors - 1;
+    Sector_t end = (*last + 1) & ~m;
+    *first = (*first + m) & ~m;
+    if (end <= *first) {
+      return false;
+    }
+    *last = end - 1;
+  }
+  return *first <= *last;
+}
 //==============================================================================
 /**
  * \class scr_t
@@ -394,6 +420,45 @@ struct scr_t {
     return 400 + 100 * sdSpecX();
   }
 };
+//------------------------------------------------------------------------------
+/** Erase the whole erase groups in a range of sectors.
+ *
+ * \param[in] card The card.
+ * \param[in] firstSector The address of the first sector in the range.
+ * \param[in] lastSector The address of the last sector in the range.
+ *
+ * \return true for success or false for failure.
+ */
+template <class Card>
+bool sdDiscardSectors(Card* card, Sector_t firstSector, Sector_t lastSector) {
+  csd_t csd;
+  if (!card->readCSD(&csd)) {
+    return false;
+  }
+  if (!sdEraseAlign(csd.eraseSectors(), &firstSector, &lastSector)) {
+    return true;
+  }
+  return card->erase(firstSector, lastSector);
+}
+/** Set a range of sectors to zero with erase.
+ *
+ * \param[in] card The card.
+ * \param[in] firstSector The address of the first sector in the range.
+ * \param[in] lastSector The address of the last sector in the range.
+ *
+ * \return true if the range was zeroed.  false if the card does not
+ * erase to zero, does not support single sector erase, or fails.
+ */
+template <class Card>
+bool sdZeroSectors(Card* card, Sector_t firstSector, Sector_t lastSector) {
+  csd_t csd;
+  scr_t scr;
+  if (!card->readSCR(&scr) || scr.dataAfterErase() || !card->readCSD(&csd) ||
+      !csd.eraseSingleBlock()) {
+    return false;
+  }
+  return card->erase(firstSector, lastSector);
+}
 //==============================================================================
 /**
  * \class sds_t
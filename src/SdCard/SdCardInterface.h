@@ -29,6 +29,7 @@
 #pragma once
 #include "../common/FsBlockDeviceInterface.h"
 #include "SdCardInfo.h"
+#include "SdLatencyStats.h"
 /**
  * \class SdCardInterface
  * \brief Abstract interface for an SD card.
@@ -42,6 +43,13 @@ class SdCardInterface : public FsBlockDeviceInterface {
    * \return true for success or false for failure.
    */
   virtual bool cardCMD6(uint32_t arg, uint8_t* status) = 0;
+  /** \return Allocation unit size in sectors from the SD status or zero
+   * for error.
+   */
+  uint32_t allocationUnitSectors() override {
+    sds_t sds;
+    return readSDS(&sds) ? 2 * sds.auSizeKB() : 0;
+  }
   /** Erase a range of sectors.
    *
    * \param[in] firstSector The address of the first sector in the range.
@@ -50,6 +58,27 @@ class SdCardInterface : public FsBlockDeviceInterface {
    * \return true for success or false for failure.
    */
   virtual bool erase(Sector_t firstSector, Sector_t lastSector) = 0;
+  /** Erase the whole erase groups in a range of sectors.
+   *
+   * \param[in] firstSector The address of the first sector in the range.
+   * \param[in] lastSector The address of the last sector in the range.
+   *
+   * \return true for success or false for failure.
+   */
+  bool discardSectors(Sector_t firstSector, Sector_t lastSector) override {
+    return sdDiscardSectors(this, firstSector, lastSector);
+  }
+  /** Set a range of sectors to zero with erase.
+   *
+   * \param[in] firstSector The address of the first sector in the range.
+   * \param[in] lastSector The address of the last sector in the range.
+   *
+   * \return true if the range was zeroed.  false if the card does not
+   * erase to zero, does not support single sector erase, or fails.
+   */
+  bool zeroSectors(Sector_t firstSector, Sector_t lastSector) override {
+    return sdZeroSectors(this, firstSector, lastSector);
+  }
   /** \return error code. */
   virtual uint8_t errorCode() const = 0;
   /** \return error data. */
@@ -60,6 +89,10 @@ class SdCardInterface : public FsBlockDeviceInterface {
   virtual bool isDedicatedSpi() { return false; }
   /** \return false by default */
   virtual bool isSpi() { return false; }
+  /** \return Command latency histograms or nullptr if SD_LATENCY_STATS
+   * is zero.
+   */
+  virtual SdLatencyStats* latencyStats() { return nullptr; }
   /** Set SPI sharing state
    * \param[in] value desired state.
    * \return false by default.
@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include "SdLatencyStats.h"
+#if SD_LATENCY_STATS
+#include <string.h>
+//------------------------------------------------------------------------------
+void SdLatencyStats::clear() {
+  m_depth = 0;
+  memset(m_count, 0, sizeof(m_count));
+  memset(m_max, 0, sizeof(m_max));
+  memset(m_bucket, 0, sizeof(m_bucket));
+}
+//------------------------------------------------------------------------------
+void SdLatencyStats::printStats(print_t* pr) const {
+  static const char* const name[CLASS_COUNT] = {
+      "read1", "readN", "write1", "writeN", "busy", "sync"};
+  pr->println(F("class,count,p50_us,p99_us,p999_us,max_us"));
+  for (uint8_t cls = 0; cls < CLASS_COUNT; cls++) {
+    pr->print(name[cls]);
+    pr->write(',');
+    pr->print(m_count[cls]);
+    pr->write(',');
+    pr->print(quantileUs(cls, 1, 2));
+    pr->write(',');
+    pr->print(quantileUs(cls, 99, 100));
+    pr->write(',');
+    pr->print(quantileUs(cls, 999, 1000));
+    pr->write(',');
+    pr->println(m_max[cls]);
+  }
+}
+//------------------------------------------------------------------------------
+uint32_t SdLatencyStats::quantileUs(uint8_t cls, uint32_t num,
+                                    uint32_t den) const {
+  // Rank of the quantile, rounded up.
+  uint64_t rank = (static_cast<uint64_t>(m_count[cls]) * num + den - 1) / den;
+  uint64_t n = 0;
+  if (m_count[cls] == 0) {
+    return 0;
+  }
+  for (uint8_t i = 0; i < BUCKET_COUNT - 1; i++) {
+    n += m_bucket[cls][i];
+    if (n >= rank) {
+      uint32_t limit = (1UL << i) - 1;
+      return limit < m_max[cls] ? limit : m_max[cls];
+    }
+  }
+  return m_max[cls];
+}
+#endif  // SD_LATENCY_STATS
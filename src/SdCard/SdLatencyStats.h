@@ -0,0 +1,153 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * \file
+ * \brief Latency histograms for SD card commands.
+ */
+#pragma once
+#include "../common/SysCall.h"
+/**
+ * \class SdLatencyStats
+ * \brief Log2 histograms of SD card command latency.
+ *
+ * Bucket zero counts commands that took less than one microsecond and
+ * bucket i counts commands that took from 2^(i-1) to 2^i - 1 microseconds.
+ * The last bucket also counts longer commands.
+ */
+class SdLatencyStats {
+ public:
+  /** Single sector read. */
+  static const uint8_t READ_SINGLE = 0;
+  /** Multi-sector read. */
+  static const uint8_t READ_MULTI = 1;
+  /** Single sector write. */
+  static const uint8_t WRITE_SINGLE = 2;
+  /** Multi-sector write. */
+  static const uint8_t WRITE_MULTI = 3;
+  /** Wait for a busy card. */
+  static const uint8_t BUSY = 4;
+  /** syncDevice() that ends a transfer. */
+  static const uint8_t SYNC = 5;
+  /** Number of command classes. */
+  static const uint8_t CLASS_COUNT = 6;
+  /** Number of histogram buckets. */
+  static const uint8_t BUCKET_COUNT = 24;
+
+  SdLatencyStats() { clear(); }
+  /** \return Count for a histogram bucket.
+   * \param[in] cls Command class.
+   * \param[in] bucket Bucket index.
+   */
+  uint32_t bucketCount(uint8_t cls, uint8_t bucket) const {
+    return m_bucket[cls][bucket];
+  }
+  /** Clear all histograms. */
+  void clear();
+  /** \return Number of commands in a class.
+   * \param[in] cls Command class.
+   */
+  uint32_t count(uint8_t cls) const { return m_count[cls]; }
+  /** \return Maximum latency for a class in microseconds.
+   * \param[in] cls Command class.
+   */
+  uint32_t maxUs(uint8_t cls) const { return m_max[cls]; }
+  /** Print count, p50, p99, p99.9 and max in microseconds for each class.
+   * \param[in] pr Print destination.
+   */
+  void printStats(print_t* pr) const;
+  /** Upper bound for a quantile, for example p99.9 is quantileUs(cls,
+   * 999, 1000).
+   *
+   * \param[in] cls Command class.
+   * \param[in] num Quantile numerator.
+   * \param[in] den Quantile denominator.
+   * \return Upper bound in microseconds of the bucket that holds the
+   * quantile, limited to the maximum latency.
+   */
+  uint32_t quantileUs(uint8_t cls, uint32_t num, uint32_t den) const;
+  /** Add a command to a histogram.
+   * \param[in] cls Command class.
+   * \param[in] us Latency in microseconds.
+   */
+  void record(uint8_t cls, uint32_t us) {
+    // Bit length of us, limited to the last bucket.
+    uint8_t i = 0;
+    while (i < (BUCKET_COUNT - 1) && (us >> i)) {
+      i++;
+    }
+    m_bucket[cls][i]++;
+    m_count[cls]++;
+    if (us > m_max[cls]) {
+      m_max[cls] = us;
+    }
+  }
+
+ private:
+  friend class SdLatencyTimer;
+  uint8_t m_depth;
+  uint32_t m_count[CLASS_COUNT];
+  uint32_t m_max[CLASS_COUNT];
+  uint32_t m_bucket[CLASS_COUNT][BUCKET_COUNT];
+};
+#if SD_LATENCY_STATS
+/**
+ * \class SdLatencyTimer
+ * \brief Records the latency of a command when it goes out of scope.
+ *
+ * Timers nest so a command that calls other commands is recorded once
+ * in the class of the outer command.
+ */
+class SdLatencyTimer {
+ public:
+  /** Start timing a command.
+   * \param[in] stats Histograms for the card.
+   * \param[in] cls Command class.
+   */
+  SdLatencyTimer(SdLatencyStats* stats, uint8_t cls)
+      : m_stats(stats), m_cls(cls) {
+    if (m_stats->m_depth++ == 0) {
+      m_start = micros();
+    }
+  }
+  ~SdLatencyTimer() {
+    if (--m_stats->m_depth == 0) {
+      m_stats->record(m_cls, micros() - m_start);
+    }
+  }
+
+ private:
+  SdLatencyStats* m_stats;
+  uint32_t m_start;
+  uint8_t m_cls;
+};
+/** Time a command for the card member m_latencyStats. */
+#define SD_LATENCY_TIMER(cls) \
+  SdLatencyTimer latencyTimer(&m_latencyStats, cls)
+/** Busy time histograms for SdBusyWait. */
+#define SD_BUSY_STATS (&m_latencyStats)
+#else  // SD_LATENCY_STATS
+#define SD_LATENCY_TIMER(cls)
+#define SD_BUSY_STATS nullptr
+#endif  // SD_LATENCY_STATS
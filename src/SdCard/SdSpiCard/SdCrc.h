@@ -0,0 +1,54 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * \file
+ * \brief CRC functions for SPI access to SD cards.
+ */
+#pragma once
+#include <stddef.h>
+
+#include "../../common/SysCall.h"
+#if USE_SD_CRC
+/**
+ * Compute the CRC7 for an SD command.
+ *
+ * \param[in] data Command bytes.
+ * \param[in] n Number of bytes.
+ * \return CRC7 in bits 1-7 with bit 0 set to one.
+ */
+uint8_t sdCrc7(const uint8_t* data, uint8_t n);
+/**
+ * Compute the CRC-CCITT for SD data.  The x^16 + x^12 + x^5 + 1
+ * polynomial is used with a zero initial value.
+ *
+ * If USE_SD_CRC is 4, this function must be defined in the application.
+ * This allows use of a hardware CRC unit.
+ *
+ * \param[in] data Data bytes.
+ * \param[in] n Number of bytes.
+ * \return CRC-CCITT.
+ */
+uint16_t sdCrcCcitt(const uint8_t* data, size_t n);
+#endif  // USE_SD_CRC
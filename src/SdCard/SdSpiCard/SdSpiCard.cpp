@@ -23,6 +23,9 @@
  * DEALINGS IN THE SOFTWARE.
  */
 #include "SdSpiCard.h"
+
+#include "../SdBusy.h"
+#include "SdCrc.h"
 //==============================================================================
 namespace {  // Avoid conflict with another Timeout class.
 class Timeout {
@@ -38,96 +41,14 @@ class Timeout {
 };
 }  // namespace
 //==============================================================================
-#if USE_SD_CRC
-// CRC functions
-//------------------------------------------------------------------------------
-static uint8_t CRC7(const uint8_t* data, uint8_t n) {
-  uint8_t crc = 0;
-  for (uint8_t i = 0; i < n; i++) {
-    uint8_t d = data[i];
-    for (uint8_t j = 0; j < 8; j++) {
-      crc <<= 1;
-      if ((d & 0x80) ^ (crc & 0x80)) {
-        crc ^= 0x09;
-      }
-      d <<= 1;
-    }
-  }
-  return (crc << 1) | 1;
-}
-//------------------------------------------------------------------------------
-#if USE_SD_CRC == 1
-// Shift based CRC-CCITT
-// uses the x^16,x^12,x^5,x^1 polynomial.
-static uint16_t CRC_CCITT(const uint8_t* data, size_t n) {
-  uint16_t crc = 0;
-  for (size_t i = 0; i < n; i++) {
-    crc = (uint8_t)(crc >> 8) | (crc << 8);
-    crc ^= data[i];
-    crc ^= (uint8_t)(crc & 0xff) >> 4;
-    crc ^= crc << 12;
-    crc ^= (crc & 0xff) << 5;
-  }
-  return crc;
-}
-#elif USE_SD_CRC > 1  // CRC_CCITT
-//------------------------------------------------------------------------------
-// Table based CRC-CCITT
-// uses the x^16,x^12,x^5,x^1 polynomial.
-#ifdef __AVR__
-static const uint16_t crctab[] PROGMEM = {
-#else   // __AVR__
-static const uint16_t crctab[] = {
-#endif  // __AVR__
-    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7, 0x8108,
-    0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF, 0x1231, 0x0210,
-    0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6, 0x9339, 0x8318, 0xB37B,
-    0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE, 0x2462, 0x3443, 0x0420, 0x1401,
-    0x64E6, 0x74C7, 0x44A4, 0x5485, 0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE,
-    0xF5CF, 0xC5AC, 0xD58D, 0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6,
-    0x5695, 0x46B4, 0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D,
-    0xC7BC, 0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
-    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B, 0x5AF5,
-    0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12, 0xDBFD, 0xCBDC,
-    0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A, 0x6CA6, 0x7C87, 0x4CE4,
-    0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41, 0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD,
-    0xAD2A, 0xBD0B, 0x8D68, 0x9D49, 0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13,
-    0x2E32, 0x1E51, 0x0E70, 0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A,
-    0x9F59, 0x8F78, 0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E,
-    0xE16F, 0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
-    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E, 0x02B1,
-    0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256, 0xB5EA, 0xA5CB,
-    0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D, 0x34E2, 0x24C3, 0x14A0,
-    0x0481, 0x7466, 0x6447, 0x5424, 0x4405, 0xA7DB, 0xB7FA, 0x8799, 0x97B8,
-    0xE75F, 0xF77E, 0xC71D, 0xD73C, 0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657,
-    0x7676, 0x4615, 0x5634, 0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9,
-    0xB98A, 0xA9AB, 0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882,
-    0x28A3, 0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
-    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92, 0xFD2E,
-    0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9, 0x7C26, 0x6C07,
-    0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1, 0xEF1F, 0xFF3E, 0xCF5D,
-    0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8, 0x6E17, 0x7E36, 0x4E55, 0x5E74,
-    0x2E93, 0x3EB2, 0x0ED1, 0x1EF0};
-static uint16_t CRC_CCITT(const uint8_t* data, size_t n) {
-  uint16_t crc = 0;
-  for (size_t i = 0; i < n; i++) {
-#ifdef __AVR__
-    crc = pgm_read_word(&crctab[(crc >> 8 ^ data[i]) & 0XFF]) ^ (crc << 8);
-#else   // __AVR__
-    crc = crctab[(crc >> 8 ^ data[i]) & 0XFF] ^ (crc << 8);
-#endif  // __AVR__
-  }
-  return crc;
-}
-#endif  // CRC_CCITT
-#endif  // USE_SD_CRC
-//==============================================================================
 // SdSpiCard member functions
 //------------------------------------------------------------------------------
 bool SdSpiCard::begin(SdSpiConfig spiConfig) {
   uint8_t cardType;
   uint32_t arg;
+  csd_t csd;
   Timeout timeout;
+  SdBusyWait busyWait;
   // Restore state to creator.
   initSharedSpiCard();
   m_errorCode = SD_CARD_ERROR_NONE;
@@ -139,6 +60,13 @@ bool SdSpiCard::begin(SdSpiConfig spiConfig) {
     goto fail;
   }
 #endif  // SPI_DRIVER_SELECT
+#if !USE_SD_CRC
+  // SCK tuning needs CRC checked reads.
+  if (spiOptionTuneSck(spiConfig.options)) {
+    sdError(SD_CARD_ERROR_INVALID_CARD_CONFIG);
+    goto fail;
+  }
+#endif  // !USE_SD_CRC
   sdCsInit(m_csPin);
   spiUnselect();
   spiSetSckSpeed(1000UL * SD_MAX_INIT_RATE_KHZ);
@@ -197,6 +125,7 @@ bool SdSpiCard::begin(SdSpiConfig spiConfig) {
       sdError(SD_CARD_ERROR_ACMD41);
       goto fail;
     }
+    busyWait.poll();
   }
   // if SD2 read OCR register to check for SDHC card
   if (cardType == SD_CARD_TYPE_SD2) {
@@ -214,9 +143,22 @@ bool SdSpiCard::begin(SdSpiConfig spiConfig) {
   }
   spiStop();
   spiSetSckSpeed(spiConfig.maxSck);
+  m_sckSpeed = spiConfig.maxSck;
   m_type = cardType;
+#if USE_SD_CRC
+  m_crcErrorCount = 0;
+  if (spiOptionTuneSck(spiConfig.options) && !tuneSckSpeed(spiConfig.maxSck)) {
+    goto fail;
+  }
+#endif  // USE_SD_CRC
+  // Erase group size for discardSectors() and erase().
+  if (!readCSD(&csd)) {
+    goto fail;
+  }
+  m_eraseSectors = csd.eraseSectors();
 #if ENABLE_DEDICATED_SPI
   m_dedicatedSpi = spiOptionDedicated(spiConfig.options);
+  m_resumableSpi = spiOptionResumable(spiConfig.options);
 #endif
   return true;
 
@@ -263,7 +205,7 @@ uint8_t SdSpiCard::cardCommand(uint8_t cmd, uint32_t arg) {
   buf[4] = (uint8_t)arg;
 
   // add CRC
-  buf[5] = CRC7(buf, 5);
+  buf[5] = sdCrc7(buf, 5);
 
   // send message
   spiSend(buf, 6);
@@ -301,14 +243,10 @@ void SdSpiCard::end() {
 }
 //------------------------------------------------------------------------------
 bool SdSpiCard::erase(Sector_t firstSector, Sector_t lastSector) {
-  csd_t csd;
-  if (!readCSD(&csd)) {
-    goto fail;
-  }
   // check for single sector erase
-  if (!csd.eraseSingleBlock()) {
+  if (m_eraseSectors > 1) {
     // erase size mask
-    uint8_t m = csd.eraseSize() - 1;
+    uint8_t m = m_eraseSectors - 1;
     if ((firstSector & m) != 0 || ((lastSector + 1) & m) != 0) {
       // error card can't erase specified area
       sdError(SD_CARD_ERROR_ERASE_SINGLE_SECTOR);
@@ -336,10 +274,7 @@ fail:
   return false;
 }
 //------------------------------------------------------------------------------
-bool SdSpiCard::eraseSingleSectorEnable() {
-  csd_t csd;
-  return readCSD(&csd) ? csd.eraseSingleBlock() : false;
-}
+bool SdSpiCard::eraseSingleSectorEnable() { return m_eraseSectors == 1; }
 //------------------------------------------------------------------------------
 bool SdSpiCard::isBusy() {
   if (m_state == READ_STATE) {
@@ -363,16 +298,7 @@ bool SdSpiCard::readData(uint8_t* dst, size_t count) {
   uint16_t crc;
 #endif  // USE_SD_CRC
 
-  // wait for start sector token
-  Timeout timeout(SD_READ_TIMEOUT);
-  while ((m_status = spiReceive()) == 0XFF) {
-    if (timeout.timedOut()) {
-      sdError(SD_CARD_ERROR_READ_TIMEOUT);
-      goto fail;
-    }
-  }
-  if (m_status != DATA_START_SECTOR) {
-    sdError(SD_CARD_ERROR_READ_TOKEN);
+  if (!waitStartToken()) {
     goto fail;
   }
   // transfer data
@@ -386,7 +312,8 @@ bool SdSpiCard::readData(uint8_t* dst, size_t count) {
 #if USE_SD_CRC
   // get crc
   crc = (spiReceive() << 8) | spiReceive();
-  if (crc != CRC_CCITT(dst, count)) {
+  if (crc != sdCrcCcitt(dst, count)) {
+    m_crcErrorCount++;
     sdError(SD_CARD_ERROR_READ_CRC);
     goto fail;
   }
@@ -402,6 +329,61 @@ fail:
   return false;
 }
 //------------------------------------------------------------------------------
+bool SdSpiCard::readDataSectors(uint8_t* dst, size_t ns) {
+#if SPI_DRIVER_SELECT == 3 && USE_SD_CRC
+  if (ns > 1 && m_spiDriverPtr->hasAsyncReceive()) {
+    return readDataPipelined(dst, ns);
+  }
+#endif  // SPI_DRIVER_SELECT == 3 && USE_SD_CRC
+  for (size_t i = 0; i < ns; i++, dst += 512) {
+    if (!readData(dst, 512)) {
+      return false;
+    }
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+#if SPI_DRIVER_SELECT == 3 && USE_SD_CRC
+// Check the CRC of each sector while the next sector is received.
+bool SdSpiCard::readDataPipelined(uint8_t* dst, size_t ns) {
+  uint8_t* prev = nullptr;
+  uint16_t prevCrc = 0;
+  bool crcOk;
+  for (size_t i = 0; i < ns; i++, dst += 512) {
+    if (!waitStartToken()) {
+      goto fail;
+    }
+    if ((m_status = m_spiDriverPtr->receiveStart(dst, 512))) {
+      sdError(SD_CARD_ERROR_DMA);
+      goto fail;
+    }
+    crcOk = !prev || prevCrc == sdCrcCcitt(prev, 512);
+    if ((m_status = m_spiDriverPtr->receiveWait())) {
+      sdError(SD_CARD_ERROR_DMA);
+      goto fail;
+    }
+    prevCrc = spiReceive() << 8;
+    prevCrc |= spiReceive();
+    if (!crcOk) {
+      m_crcErrorCount++;
+      sdError(SD_CARD_ERROR_READ_CRC);
+      goto fail;
+    }
+    prev = dst;
+  }
+  if (prev && prevCrc != sdCrcCcitt(prev, 512)) {
+    m_crcErrorCount++;
+    sdError(SD_CARD_ERROR_READ_CRC);
+    goto fail;
+  }
+  return true;
+
+fail:
+  spiStop();
+  return false;
+}
+#endif  // SPI_DRIVER_SELECT == 3 && USE_SD_CRC
+//------------------------------------------------------------------------------
 bool SdSpiCard::readOCR(uint32_t* ocr) {
   uint8_t* p = reinterpret_cast<uint8_t*>(ocr);
   if (cardCommand(CMD58, 0)) {
@@ -459,6 +441,7 @@ fail:
 }
 //------------------------------------------------------------------------------
 bool SdSpiCard::readSector(Sector_t sector, uint8_t* dst) {
+  SD_LATENCY_TIMER(SdLatencyStats::READ_SINGLE);
 #if ENABLE_DEDICATED_SPI
   return readSectors(sector, dst, 1);
 #else
@@ -483,32 +466,43 @@ fail:
 }
 //------------------------------------------------------------------------------
 bool SdSpiCard::readSectors(Sector_t sector, uint8_t* dst, size_t ns) {
+  SD_LATENCY_TIMER(ns == 1 ? SdLatencyStats::READ_SINGLE
+                           : SdLatencyStats::READ_MULTI);
 #if ENABLE_DEDICATED_SPI
   if (sdState() != READ_STATE || sector != m_curSector) {
     if (!readStart(sector)) {
       goto fail;
     }
     m_curSector = sector;
+  } else if (!m_spiActive) {
+    // Resume a transfer that released the bus.
+    spiStart();
   }
-  for (size_t i = 0; i < ns; i++, dst += 512) {
-    if (!readData(dst)) {
-      goto fail;
-    }
+  if (!readDataSectors(dst, ns)) {
+    goto fail;
   }
   m_curSector += ns;
+  if (m_resumableSpi && !m_dedicatedSpi) {
+    spiStop();
+    return true;
+  }
   return m_dedicatedSpi ? true : readStop();
 #else
   if (!readStart(sector)) {
     goto fail;
   }
-  for (size_t i = 0; i < ns; i++, dst += 512) {
-    if (!readData(dst, 512)) {
-      goto fail;
-    }
+  if (!readDataSectors(dst, ns)) {
+    goto fail;
   }
   return readStop();
 #endif
 fail:
+  // Never resume a broken transfer.
+  if (m_state == READ_STATE) {
+    uint8_t errorCode = m_errorCode;
+    readStop();
+    m_errorCode = errorCode;
+  }
   return false;
 }
 //------------------------------------------------------------------------------
@@ -560,6 +554,18 @@ fail:
   return false;
 }
 //------------------------------------------------------------------------------
+#if USE_SD_CRC
+bool SdSpiCard::sckSpeedOk(uint8_t* buf) {
+  for (uint16_t i = 0; i < SD_SCK_TUNE_READS; i++) {
+    if (!readSector(i, buf)) {
+      return false;
+    }
+  }
+  // End the transfer so the next rate starts with a new command.
+  return syncDevice();
+}
+#endif  // USE_SD_CRC
+//------------------------------------------------------------------------------
 Sector_t SdSpiCard::sectorCount() {
   csd_t csd;
   return readCSD(&csd) ? csd.capacity() : 0;
@@ -581,11 +587,19 @@ bool SdSpiCard::setDedicatedSpi(bool value) {
 void SdSpiCard::spiStart() {
   SPI_ASSERT_NOT_ACTIVE;
   if (!m_spiActive) {
+#if ENABLE_DEDICATED_SPI
+    if (m_busAcquire) {
+      m_busAcquire();
+    }
+#endif  // ENABLE_DEDICATED_SPI
     spiActivate();
     m_spiActive = true;
     spiSelect();
-    // Dummy byte to drive MISO busy status.
-    spiSend(0XFF);
+    // Dummy byte to drive MISO busy status.  Not sent in a resumed read
+    // since it could be the start token.
+    if (m_state != READ_STATE) {
+      spiSend(0XFF);
+    }
   }
 }
 //------------------------------------------------------------------------------
@@ -597,10 +611,19 @@ void SdSpiCard::spiStop() {
     spiSend(0XFF);
     spiDeactivate();
     m_spiActive = false;
+#if ENABLE_DEDICATED_SPI
+    if (m_busRelease) {
+      m_busRelease();
+    }
+#endif  // ENABLE_DEDICATED_SPI
   }
 }
 //------------------------------------------------------------------------------
 bool SdSpiCard::syncDevice() {
+  if (m_state == IDLE_STATE) {
+    return true;
+  }
+  SD_LATENCY_TIMER(SdLatencyStats::SYNC);
   if (m_state == WRITE_STATE) {
     return writeStop();
   }
@@ -610,12 +633,87 @@ bool SdSpiCard::syncDevice() {
   return true;
 }
 //------------------------------------------------------------------------------
+#if USE_SD_CRC
+bool SdSpiCard::tuneSckSpeed(uint32_t maxSck) {
+  uint8_t buf[512];
+  uint32_t good = 1000UL * SD_MAX_INIT_RATE_KHZ;
+  uint32_t bad = 0;
+  uint32_t sck;
+  uint32_t crcErrorCount = m_crcErrorCount;
+  if (maxSck <= good) {
+    // Nothing to tune.  Never exceed maxSck.
+    spiSetSckSpeed(maxSck);
+    m_sckSpeed = maxSck;
+    return true;
+  }
+  sck = good;
+  if (!syncDevice()) {
+    goto fail;
+  }
+  // Double the rate until a read fails.
+  while (sck < maxSck) {
+    sck = sck <= maxSck / 2 ? 2 * sck : maxSck;
+    spiSetSckSpeed(sck);
+    if (!sckSpeedOk(buf)) {
+      bad = sck;
+      break;
+    }
+    good = sck;
+  }
+  // Bisect between the last good rate and the first bad rate.
+  while (bad && (bad - good) > good / 16) {
+    sck = good + (bad - good) / 2;
+    spiSetSckSpeed(sck);
+    if (sckSpeedOk(buf)) {
+      good = sck;
+    } else {
+      bad = sck;
+    }
+  }
+  spiSetSckSpeed(good);
+  m_sckSpeed = good;
+  // Errors at rates that were rejected are not link errors.
+  m_crcErrorCount = crcErrorCount;
+  if (!sckSpeedOk(buf)) {
+    goto fail;
+  }
+  m_errorCode = SD_CARD_ERROR_NONE;
+  return true;
+
+fail:
+  return false;
+}
+#endif  // USE_SD_CRC
+//------------------------------------------------------------------------------
 bool SdSpiCard::waitReady(uint16_t ms) {
   Timeout timeout(ms);
+  SdBusyWait busyWait(SD_BUSY_STATS);
   while (spiReceive() != 0XFF) {
     if (timeout.timedOut()) {
       return false;
     }
+    busyWait.poll();
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+bool SdSpiCard::waitStartToken() {
+  Timeout timeout(SD_READ_TIMEOUT);
+  while ((m_status = spiReceive()) == 0XFF) {
+    if (timeout.timedOut()) {
+      sdError(SD_CARD_ERROR_READ_TIMEOUT);
+      return false;
+    }
+#if USE_SD_BUSY_CALLBACK
+    // Read access time is short so yield but do not sleep.
+    if (SdBusy::yieldCallback) {
+      SdBusy::yieldCallback();
+    }
+#endif  // USE_SD_BUSY_CALLBACK
+  }
+  if (m_status != DATA_START_SECTOR) {
+    sdError(SD_CARD_ERROR_READ_TOKEN);
+    return false;
   }
   return true;
 }
@@ -639,7 +737,7 @@ fail:
 // send one sector of data for write sector or write multiple sectors
 bool SdSpiCard::writeData(uint8_t token, const uint8_t* src) {
 #if USE_SD_CRC
-  uint16_t crc = CRC_CCITT(src, 512);
+  uint16_t crc = sdCrcCcitt(src, 512);
 #else   // USE_SD_CRC
   uint16_t crc = 0XFFFF;
 #endif  // USE_SD_CRC
@@ -650,6 +748,11 @@ bool SdSpiCard::writeData(uint8_t token, const uint8_t* src) {
 
   m_status = spiReceive();
   if ((m_status & DATA_RES_MASK) != DATA_RES_ACCEPTED) {
+#if USE_SD_CRC
+    if ((m_status & DATA_RES_MASK) == DATA_RES_CRC_ERROR) {
+      m_crcErrorCount++;
+    }
+#endif  // USE_SD_CRC
     sdError(SD_CARD_ERROR_WRITE_DATA);
     goto fail;
   }
@@ -661,9 +764,10 @@ fail:
 }
 //------------------------------------------------------------------------------
 bool SdSpiCard::writeSector(Sector_t sector, const uint8_t* src) {
+  SD_LATENCY_TIMER(SdLatencyStats::WRITE_SINGLE);
 #ifndef OLD_WAY_WRITE_SECTOR
 #if ENABLE_DEDICATED_SPI
-  if (m_dedicatedSpi) {
+  if (m_dedicatedSpi || m_resumableSpi) {
     return writeSectors(sector, src, 1);
   }
 #endif
@@ -702,12 +806,29 @@ fail:
 }
 //------------------------------------------------------------------------------
 bool SdSpiCard::writeSectors(Sector_t sector, const uint8_t* src, size_t ns) {
+  return writeSectorsPreErase(sector, src, ns, 0);
+}
+//------------------------------------------------------------------------------
+bool SdSpiCard::writeSectorsPreErase(Sector_t sector, const uint8_t* src,
+                                     size_t ns, uint32_t eraseCount) {
+  SD_LATENCY_TIMER(ns == 1 ? SdLatencyStats::WRITE_SINGLE
+                           : SdLatencyStats::WRITE_MULTI);
+  // A shared SPI write is stopped after ns sectors.
+  if (!isDedicatedSpi() && !isResumableSpi() && eraseCount > ns) {
+    if (ns == 1) {
+      return writeSector(sector, src);
+    }
+    eraseCount = ns;
+  }
 #if ENABLE_DEDICATED_SPI
   if (sdState() != WRITE_STATE || m_curSector != sector) {
-    if (!writeStart(sector)) {
+    if (!writeStart(sector, eraseCount)) {
       goto fail;
     }
     m_curSector = sector;
+  } else if (!m_spiActive) {
+    // Resume a transfer that released the bus.
+    spiStart();
   }
   for (size_t i = 0; i < ns; i++, src += 512) {
     if (!writeData(src)) {
@@ -715,9 +836,13 @@ bool SdSpiCard::writeSectors(Sector_t sector, const uint8_t* src, size_t ns) {
     }
   }
   m_curSector += ns;
+  if (m_resumableSpi && !m_dedicatedSpi) {
+    spiStop();
+    return true;
+  }
   return m_dedicatedSpi ? true : writeStop();
 #else
-  if (!writeStart(sector)) {
+  if (!writeStart(sector, eraseCount)) {
     goto fail;
   }
   for (size_t i = 0; i < ns; i++, src += 512) {
@@ -732,7 +857,17 @@ fail:
   return false;
 }
 //------------------------------------------------------------------------------
-bool SdSpiCard::writeStart(Sector_t sector) {
+bool SdSpiCard::writeStart(Sector_t sector) { return writeStart(sector, 0); }
+//------------------------------------------------------------------------------
+bool SdSpiCard::writeStart(Sector_t sector, uint32_t eraseCount) {
+  // ACMD23 count is 23 bits.
+  if (eraseCount > 0X7FFFFF) {
+    eraseCount = 0X7FFFFF;
+  }
+  if (eraseCount > 1 && cardAcmd(ACMD23, eraseCount)) {
+    sdError(SD_CARD_ERROR_ACMD23);
+    goto fail;
+  }
   // use address if not SDHC card
   if (type() != SD_CARD_TYPE_SDHC) {
     sector <<= 9;
@@ -750,6 +885,9 @@ fail:
 }
 //------------------------------------------------------------------------------
 bool SdSpiCard::writeStop() {
+  if (!m_spiActive) {
+    spiStart();
+  }
   if (!waitReady(SD_WRITE_TIMEOUT)) {
     goto fail;
   }
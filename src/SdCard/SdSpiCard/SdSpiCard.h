@@ -63,14 +63,22 @@
 #define SPI_ASSERT_NOT_ACTIVE
 #endif  // CHECK_SPI_ACTIVE
 //==============================================================================
+#if FS_BLOCK_DEVICE_ID == FS_BLOCK_DEVICE_ID_SdSpiCard
+/** Calls through a bound FsBlockDevice are direct if SdSpiCard is final. */
+#define SD_SPI_CARD_FINAL final
+#else  // FS_BLOCK_DEVICE_ID
+/** SdSpiCard is not final unless it is the bound class. */
+#define SD_SPI_CARD_FINAL
+#endif  // FS_BLOCK_DEVICE_ID
+//------------------------------------------------------------------------------
 /**
  * \class SdSpiCard
  * \brief Raw access to SD and SDHC flash memory cards via shared SPI port.
  */
 #if HAS_SDIO_CLASS
-class SdSpiCard : public SdCardInterface {
+class SdSpiCard SD_SPI_CARD_FINAL : public SdCardInterface {
 #elif USE_BLOCK_DEVICE_INTERFACE
-class SdSpiCard : public FsBlockDeviceInterface {
+class SdSpiCard SD_SPI_CARD_FINAL : public FsBlockDeviceInterface {
 #else   // HAS_SDIO_CLASS
 class SdSpiCard {
 #endif  // HAS_SDIO_CLASS
@@ -83,6 +91,13 @@ class SdSpiCard {
   static const uint8_t WRITE_STATE = 2;
   /** Construct an instance of SdSpiCard. */
   SdSpiCard() { initSharedSpiCard(); }
+  /** \return Allocation unit size in sectors from the SD status or zero
+   * for error.
+   */
+  uint32_t allocationUnitSectors() {
+    sds_t sds;
+    return readSDS(&sds) ? 2 * sds.auSizeKB() : 0;
+  }
   /** Initialize the SD card.
    * \param[in] spiConfig SPI card configuration.
    * \return true for success or false for failure.
@@ -95,6 +110,28 @@ class SdSpiCard {
    * \return true for success or false for failure.
    */
   bool cardCMD6(uint32_t arg, uint8_t* status);
+  /** Erase the whole erase groups in a range of sectors.
+   *
+   * The erase group size is read from the CSD by begin().
+   *
+   * \param[in] firstSector The address of the first sector in the range.
+   * \param[in] lastSector The address of the last sector in the range.
+   *
+   * \return true for success or false for failure.
+   */
+  bool discardSectors(Sector_t firstSector, Sector_t lastSector) {
+    return !sdEraseAlign(m_eraseSectors, &firstSector, &lastSector) ||
+           erase(firstSector, lastSector);
+  }
+#if USE_SD_CRC
+  /** \return Number of read CRC errors and writes rejected for a CRC
+   * error since begin().
+   */
+  uint32_t crcErrorCount() const { return m_crcErrorCount; }
+#else   // USE_SD_CRC
+  /** \return Zero since CRC is not checked. */
+  uint32_t crcErrorCount() const { return 0; }
+#endif  // USE_SD_CRC
   /** End use of card */
   void end();
   /** Erase a range of sectors.
@@ -145,9 +182,23 @@ class SdSpiCard {
   bool isDedicatedSpi() { return m_dedicatedSpi; }
 #else   // ENABLE_DEDICATED_SPI
   bool isDedicatedSpi() { return false; }
+#endif  // ENABLE_DEDICATED_SPI
+#if ENABLE_DEDICATED_SPI
+  /** \return true if in resumable SPI state. */
+  bool isResumableSpi() { return m_resumableSpi; }
+#else   // ENABLE_DEDICATED_SPI
+  /** \return true if in resumable SPI state. */
+  bool isResumableSpi() { return false; }
 #endif  // ENABLE_DEDICATED_SPI
   /** \return true if card is on SPI bus. */
   bool isSpi() { return true; }
+#if SD_LATENCY_STATS
+  /** \return Command latency histograms. */
+  SdLatencyStats* latencyStats() { return &m_latencyStats; }
+#else   // SD_LATENCY_STATS
+  /** \return nullptr since SD_LATENCY_STATS is zero. */
+  SdLatencyStats* latencyStats() { return nullptr; }
+#endif  // SD_LATENCY_STATS
   /**
    * Read a card's CID register. The CID contains card identification
    * information such as Manufacturer ID, Product name, Product serial
@@ -223,6 +274,11 @@ class SdSpiCard {
    * \return true for success or false for failure.
    */
   bool readStop();
+  /** \return SCK rate selected by begin() or tuneSckSpeed().
+   *
+   * \note The driver may use a lower rate if this rate is not available.
+   */
+  uint32_t sckSpeed() const { return m_sckSpeed; }
   /** \return SD multi-sector read/write state */
   uint8_t sdState() { return m_state; }
   /**
@@ -237,6 +293,21 @@ class SdSpiCard {
    * \return true for success.
    */
   bool setDedicatedSpi(bool value);
+#if ENABLE_DEDICATED_SPI
+  /** Set functions called when the card takes and releases the SPI bus.
+   *
+   * Use these to arbitrate the bus with other SPI devices, for example
+   * with an RTOS mutex.  In resumable SPI mode the bus is released after
+   * each call while a multi-sector transfer stays open.
+   *
+   * \param[in] acquire Called before chip select is asserted.
+   * \param[in] release Called after chip select is released.
+   */
+  void setSpiBusCallbacks(void (*acquire)(), void (*release)()) {
+    m_busAcquire = acquire;
+    m_busRelease = release;
+  }
+#endif  // ENABLE_DEDICATED_SPI
   /** end a multi-sector transfer.
    *
    * \return true for success or false for failure.
@@ -244,6 +315,24 @@ class SdSpiCard {
   bool stopTransfer();
   /** \return success if sync successful. Not for user apps. */
   bool syncDevice();
+#if USE_SD_CRC
+  /** Find the fastest reliable SCK rate.
+   *
+   * The rate starts at SD_MAX_INIT_RATE_KHZ and doubles, up to maxSck,
+   * while SD_SCK_TUNE_READS sectors are read without error.  The range
+   * between the last good rate and the first bad rate is then bisected
+   * to within 1/16 of the good rate.  If maxSck is not above
+   * SD_MAX_INIT_RATE_KHZ, maxSck is used without tuning.
+   *
+   * \param[in] maxSck Maximum SCK rate to try.
+   *
+   * \note begin() calls this if TUNE_SPI_SCK is set in the SdSpiConfig
+   * options.  A 512 byte buffer is allocated on the stack.
+   *
+   * \return true for success or false for failure.
+   */
+  bool tuneSckSpeed(uint32_t maxSck);
+#endif  // USE_SD_CRC
   /** Return the card type: SD V1, SD V2 or SDHC/SDXC
    * \return 0 - SD V1, 1 - SD V2, or 3 - SDHC/SDXC.
    */
@@ -265,6 +354,22 @@ class SdSpiCard {
    * \return true for success or false for failure.
    */
   bool writeSectors(Sector_t sector, const uint8_t* src, size_t ns);
+  /**
+   * Write multiple 512 byte sectors with a hint for pre-erase.
+   *
+   * \param[in] sector Logical sector to be written.
+   * \param[in] src Pointer to the location of the data to be written.
+   * \param[in] ns Number of sectors to be written.
+   * \param[in] eraseCount Number of sectors, starting at sector, that will
+   * be written by this and following sequential writes.
+   *
+   * \note In dedicated SPI mode the write stays open so eraseCount is sent
+   * with ACMD23.  In shared mode only ns sectors are pre-erased.
+   *
+   * \return true for success or false for failure.
+   */
+  bool writeSectorsPreErase(Sector_t sector, const uint8_t* src, size_t ns,
+                            uint32_t eraseCount);
   /** Write one data sector in a multiple sector write sequence.
    * \param[in] src Pointer to the location of the data to be written.
    * \return true for success or false for failure.
@@ -280,12 +385,36 @@ class SdSpiCard {
    * \return true for success or false for failure.
    */
   bool writeStart(Sector_t sector);
+  /** Start a write multiple sectors sequence with pre-erase.
+   *
+   * \param[in] sector Address of first sector in sequence.
+   * \param[in] eraseCount The number of sectors to be pre-erased.
+   *
+   * \note ACMD23 is sent before CMD25 if eraseCount is greater than one.
+   * Sectors that are pre-erased but not written have undefined content.
+   *
+   * \return true for success or false for failure.
+   */
+  bool writeStart(Sector_t sector, uint32_t eraseCount);
 
   /** End a write multiple sectors sequence.
    *
    * \return true for success or false for failure.
    */
   bool writeStop();
+#if !HAS_SDIO_CLASS
+  /** Set a range of sectors to zero with erase.
+   *
+   * \param[in] firstSector The address of the first sector in the range.
+   * \param[in] lastSector The address of the last sector in the range.
+   *
+   * \return true if the range was zeroed.  false if the card does not
+   * erase to zero, does not support single sector erase, or fails.
+   */
+  bool zeroSectors(Sector_t firstSector, Sector_t lastSector) {
+    return sdZeroSectors(this, firstSector, lastSector);
+  }
+#endif  // !HAS_SDIO_CLASS
 
  private:
   // private functions
@@ -295,12 +424,20 @@ class SdSpiCard {
   }
   uint8_t cardCommand(uint8_t cmd, uint32_t arg);
   bool readData(uint8_t* dst, size_t count);
+  bool readDataSectors(uint8_t* dst, size_t ns);
+#if SPI_DRIVER_SELECT == 3 && USE_SD_CRC
+  bool readDataPipelined(uint8_t* dst, size_t ns);
+#endif  // SPI_DRIVER_SELECT == 3 && USE_SD_CRC
   bool readRegister(uint8_t cmd, void* buf);
   void spiSelect() { sdCsWrite(m_csPin, false); }
   void spiStart();
   void spiStop();
   void spiUnselect() { sdCsWrite(m_csPin, true); }
   bool waitReady(uint16_t ms);
+  bool waitStartToken();
+#if USE_SD_CRC
+  bool sckSpeedOk(uint8_t* buf);
+#endif  // USE_SD_CRC
   bool writeData(uint8_t token, const uint8_t* src);
 #if SPI_DRIVER_SELECT < 2
   void spiActivate() { m_spiDriver.activate(); }
@@ -353,18 +490,35 @@ class SdSpiCard {
   void initSharedSpiCard() {
     m_beginCalled = false;
     m_csPin = 0;
+    m_eraseSectors = 0;
     m_errorCode = SD_CARD_ERROR_INIT_NOT_CALLED;
     m_spiActive = false;
     m_state = IDLE_STATE;
     m_status = 0;
     m_type = 0;
+#if ENABLE_DEDICATED_SPI
+    // Options from a previous begin() must not apply during init.
+    m_dedicatedSpi = false;
+    m_resumableSpi = false;
+#endif  // ENABLE_DEDICATED_SPI
   }
 #if ENABLE_DEDICATED_SPI
+  void (*m_busAcquire)() = nullptr;
+  void (*m_busRelease)() = nullptr;
   Sector_t m_curSector = 0;
   bool m_dedicatedSpi = false;
+  bool m_resumableSpi = false;
 #endif  // ENABLE_DEDICATED_SPI
+#if USE_SD_CRC
+  uint32_t m_crcErrorCount = 0;
+#endif  // USE_SD_CRC
+#if SD_LATENCY_STATS
+  SdLatencyStats m_latencyStats;
+#endif  // SD_LATENCY_STATS
+  uint32_t m_sckSpeed = 0;
   bool m_beginCalled;
   SdCsPin_t m_csPin;
+  uint8_t m_eraseSectors;
   uint8_t m_errorCode;
   bool m_spiActive;
   uint8_t m_state;
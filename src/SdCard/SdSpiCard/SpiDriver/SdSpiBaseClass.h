@@ -44,6 +44,12 @@ class SdSpiBaseClass {
   virtual void deactivate() {}
   /** deactivate SPI driver. */
   virtual void end() {}
+  /** \return true if receiveStart() returns before the transfer is done.
+   *
+   * SdSpiCard checks the CRC of a sector while the next sector is
+   * received if this is true.
+   */
+  virtual bool hasAsyncReceive() { return false; }
   /** Receive a byte.
    *
    * \return The byte.
@@ -57,6 +63,23 @@ class SdSpiBaseClass {
    * \return Zero for no error or nonzero error code.
    */
   virtual uint8_t receive(uint8_t* buf, size_t count) = 0;
+  /** Start receiving multiple bytes, for example with DMA.
+   *
+   * \param[out] buf Buffer to receive the data.
+   * \param[in] count Number of bytes to receive.
+   *
+   * \note The default calls receive(buf, count).
+   *
+   * \return Zero for no error or nonzero error code.
+   */
+  virtual uint8_t receiveStart(uint8_t* buf, size_t count) {
+    return receive(buf, count);
+  }
+  /** Wait for the transfer started by receiveStart() to complete.
+   *
+   * \return Zero for no error or nonzero error code.
+   */
+  virtual uint8_t receiveWait() { return 0; }
   /** Send a byte.
    *
    * \param[in] data Byte to send
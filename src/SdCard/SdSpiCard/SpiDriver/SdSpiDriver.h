@@ -52,6 +52,17 @@ const uint8_t DEDICATED_SPI = 1;
  * \return true for dedicated SPI.
  */
 inline bool spiOptionDedicated(uint8_t opt) { return opt & DEDICATED_SPI; }
+/**
+ * The SPI bus is shared but multi-sector transfers stay open between calls.
+ * Chip select and the bus are released after each call and the transfer
+ * resumes if the next access is the following sector.
+ */
+const uint8_t RESUMABLE_SPI = 4;
+/**
+ * \param[in] opt option field of SdSpiConfig.
+ * \return true for resumable SPI.
+ */
+inline bool spiOptionResumable(uint8_t opt) { return opt & RESUMABLE_SPI; }
 #else   // ENABLE_DEDICATED_SPI
 /**
  * \param[in] opt option field of SdSpiConfig.
@@ -61,9 +72,28 @@ inline bool spiOptionDedicated(uint8_t opt) {
   (void)opt;
   return false;
 }
+/**
+ * \param[in] opt option field of SdSpiConfig.
+ * \return true for resumable SPI.
+ */
+inline bool spiOptionResumable(uint8_t opt) {
+  (void)opt;
+  return false;
+}
 #endif  // ENABLE_DEDICATED_SPI
 /** The user will call begin. Useful for custom SPI configurations.       */
 const uint8_t USER_SPI_BEGIN = 2;
+/**
+ * Find the fastest SCK rate, up to maxSck, that reads the card without
+ * CRC errors.  Requires USE_SD_CRC nonzero.  begin() fails with
+ * SD_CARD_ERROR_INVALID_CARD_CONFIG if USE_SD_CRC is zero.
+ */
+const uint8_t TUNE_SPI_SCK = 8;
+/**
+ * \param[in] opt option field of SdSpiConfig.
+ * \return true for SCK tuning.
+ */
+inline bool spiOptionTuneSck(uint8_t opt) { return opt & TUNE_SPI_SCK; }
 //------------------------------------------------------------------------------
 /** SPISettings for SCK frequency in Hz. */
 #define SD_SCK_HZ(maxSpeed) (maxSpeed)
@@ -0,0 +1,459 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#include "SdSpiEmulator.h"
+#if SPI_DRIVER_SELECT == 3
+#include <string.h>
+
+#include "../../SdCardInfo.h"
+//------------------------------------------------------------------------------
+// R1 error bits not defined in SdCardInfo.h.
+static const uint8_t R1_COM_CRC_ERROR = 0X08;
+static const uint8_t R1_PARAMETER_ERROR = 0X40;
+// Data response tokens.
+static const uint8_t DATA_RES_WRITE_ERROR = 0X0D;
+// Read data error tokens.
+static const uint8_t DATA_ERROR_TOKEN = 0X01;
+static const uint8_t DATA_OUT_OF_RANGE_TOKEN = 0X08;
+// List of emulators for csWrite().
+static SdSpiEmulator* emulatorList = nullptr;
+//------------------------------------------------------------------------------
+static uint8_t crc7(const uint8_t* data, uint8_t n) {
+  uint8_t crc = 0;
+  for (uint8_t i = 0; i < n; i++) {
+    uint8_t d = data[i];
+    for (uint8_t j = 0; j < 8; j++) {
+      crc <<= 1;
+      if ((d & 0x80) ^ (crc & 0x80)) {
+        crc ^= 0x09;
+      }
+      d <<= 1;
+    }
+  }
+  return (crc << 1) | 1;
+}
+//------------------------------------------------------------------------------
+static uint16_t crc16(const uint8_t* data, size_t n) {
+  uint16_t crc = 0;
+  for (size_t i = 0; i < n; i++) {
+    crc = static_cast<uint8_t>(crc >> 8) | (crc << 8);
+    crc ^= data[i];
+    crc ^= static_cast<uint8_t>(crc & 0xff) >> 4;
+    crc ^= crc << 12;
+    crc ^= (crc & 0xff) << 5;
+  }
+  return crc;
+}
+//==============================================================================
+#if !ENABLE_ARDUINO_FEATURES
+__attribute__((weak)) void sdCsInit(SdCsPin_t pin) { (void)pin; }
+//------------------------------------------------------------------------------
+__attribute__((weak)) void sdCsWrite(SdCsPin_t pin, bool level) {
+  SdSpiEmulator::csWrite(pin, level);
+}
+#endif  // !ENABLE_ARDUINO_FEATURES
+//==============================================================================
+void SdSpiEmulator::begin(SdSpiConfig config) {
+  m_csPin = config.csPin;
+  if (!m_linked) {
+    m_next = emulatorList;
+    emulatorList = this;
+    m_linked = true;
+  }
+}
+//------------------------------------------------------------------------------
+void SdSpiEmulator::command() {
+  uint8_t cmd = m_cmd[0] & 0X3F;
+  uint32_t arg = static_cast<uint32_t>(m_cmd[1]) << 24 |
+                 static_cast<uint32_t>(m_cmd[2]) << 16 |
+                 static_cast<uint32_t>(m_cmd[3]) << 8 | m_cmd[4];
+  uint32_t capacity = m_dev->sectorCount() & ~static_cast<uint32_t>(1023);
+  bool appCmd = m_appCmd;
+  uint8_t r1 = m_idle ? R1_IDLE_STATE : R1_READY_STATE;
+  uint8_t buf[4];
+  m_commandCount++;
+  m_appCmd = false;
+  m_txIndex = 0;
+  m_txCount = 0;
+  // CMD0 and CMD8 always have a valid CRC.
+  if ((m_crcOn || cmd == CMD0 || cmd == CMD8) && m_cmd[5] != crc7(m_cmd, 5)) {
+    m_crcErrorCount++;
+    response(r1 | R1_COM_CRC_ERROR);
+    return;
+  }
+  if (cmd == CMD12) {
+    // Stop transmission, response follows a stuff byte.
+    m_state = IDLE_STATE;
+    response(r1);
+    m_txDelay++;
+    return;
+  }
+  m_state = IDLE_STATE;
+  if (appCmd) {
+    switch (cmd) {
+      case ACMD13:
+        buf[0] = 0;
+        response(r1, buf, 1);
+        memset(m_reg, 0, 64);
+        // 4 MB allocation unit.
+        m_reg[10] = 0X90;
+        setRegister(m_reg, 64);
+        return;
+      case ACMD23:
+        m_preEraseCount = arg & 0X7FFFFF;
+        response(r1);
+        return;
+      case ACMD41:
+        if (m_initLeft) {
+          m_initLeft--;
+        } else {
+          m_idle = false;
+        }
+        response(m_idle ? R1_IDLE_STATE : R1_READY_STATE);
+        return;
+      case ACMD51: {
+        // SD 3.0, CMD23 support, 1 and 4 bit bus.
+        static const uint8_t scr[8] = {0X02, 0X35, 0X80, 0X02, 0, 0, 0, 0};
+        response(r1);
+        setRegister(scr, sizeof(scr));
+        return;
+      }
+      default:
+        break;
+    }
+  }
+  switch (cmd) {
+    case CMD0:
+      m_idle = true;
+      m_crcOn = false;
+      m_initLeft = m_initCount;
+      response(R1_IDLE_STATE);
+      break;
+
+    case CMD6:
+      response(r1);
+      memset(m_reg, 0, 64);
+      setRegister(m_reg, 64);
+      break;
+
+    case CMD8:
+      buf[0] = 0;
+      buf[1] = 0;
+      buf[2] = (arg >> 8) & 0XF;
+      buf[3] = arg;
+      response(r1, buf, 4);
+      break;
+
+    case CMD9: {
+      // CSD version 2.0.
+      uint32_t cSize = capacity / 1024 - 1;
+      uint8_t csd[16] = {0X40, 0X0E, 0X00, 0X32, 0X5B, 0X59, 0X00, 0X00,
+                         0X00, 0X00, 0X7F, 0X80, 0X0A, 0X40, 0X00, 0X00};
+      csd[7] = (cSize >> 16) & 0X3F;
+      csd[8] = cSize >> 8;
+      csd[9] = cSize;
+      csd[15] = crc7(csd, 15);
+      response(r1);
+      setRegister(csd, 16);
+      break;
+    }
+
+    case CMD10: {
+      uint8_t cid[16] = {0XFE, 'S', 'D', 'E', 'm', 'u', 'l', 'a',
+                         0X10, 0,   0,   0,   1,   0X01, 0X91, 0};
+      cid[15] = crc7(cid, 15);
+      response(r1);
+      setRegister(cid, 16);
+      break;
+    }
+
+    case CMD13:
+      buf[0] = 0;
+      response(r1, buf, 1);
+      break;
+
+    case CMD17:
+    case CMD18:
+    case CMD24:
+    case CMD25:
+      if (m_idle) {
+        response(r1 | R1_ILLEGAL_COMMAND);
+        break;
+      }
+      if (arg >= capacity) {
+        response(r1 | R1_PARAMETER_ERROR);
+        break;
+      }
+      m_sector = arg;
+      response(r1);
+      m_state = cmd == CMD17   ? READ_BLOCK_STATE
+                : cmd == CMD18 ? READ_MULTI_STATE
+                : cmd == CMD24 ? WRITE_SINGLE_STATE
+                               : WRITE_MULTI_STATE;
+      m_regCount = 0;
+      m_rxActive = false;
+      break;
+
+    case CMD32:
+      m_eraseStart = arg;
+      response(r1);
+      break;
+
+    case CMD33:
+      m_eraseEnd = arg;
+      response(r1);
+      break;
+
+    case CMD38:
+      if (m_eraseStart > m_eraseEnd || m_eraseEnd >= capacity) {
+        response(r1 | R1_PARAMETER_ERROR);
+        break;
+      }
+      memset(m_rx, 0, 512);
+      for (uint32_t s = m_eraseStart; s <= m_eraseEnd; s++) {
+        m_dev->writeSector(s, m_rx);
+      }
+      response(r1);
+      m_busy = m_eraseBusy;
+      break;
+
+    case CMD55:
+      m_appCmd = true;
+      response(r1);
+      break;
+
+    case CMD58:
+      // Power up done, SDHC, 2.7-3.6 V.
+      buf[0] = 0XC0;
+      buf[1] = 0XFF;
+      buf[2] = 0X80;
+      buf[3] = 0X00;
+      response(r1, buf, 4);
+      break;
+
+    case CMD59:
+      m_crcOn = arg & 1;
+      response(r1);
+      break;
+
+    default:
+      response(r1 | R1_ILLEGAL_COMMAND);
+      break;
+  }
+}
+//------------------------------------------------------------------------------
+void SdSpiEmulator::csWrite(SdCsPin_t pin, bool level) {
+  for (SdSpiEmulator* emu = emulatorList; emu; emu = emu->m_next) {
+    if (emu->m_csPin == pin) {
+      emu->select(!level);
+    }
+  }
+}
+//------------------------------------------------------------------------------
+// Load the next data sector or register for a read.
+bool SdSpiEmulator::loadBlock() {
+  uint16_t n;
+  if (m_state == READ_BLOCK_STATE && m_regCount) {
+    n = m_regCount;
+    memcpy(m_tx + 1, m_reg, n);
+    m_regCount = 0;
+    m_state = IDLE_STATE;
+  } else if (m_state == READ_BLOCK_STATE || m_state == READ_MULTI_STATE) {
+    n = 512;
+    m_txIndex = 0;
+    m_txDelay = m_readLatency;
+    if (m_sector >= (m_dev->sectorCount() & ~static_cast<uint32_t>(1023))) {
+      m_tx[0] = DATA_OUT_OF_RANGE_TOKEN;
+      m_txCount = 1;
+      m_state = IDLE_STATE;
+      return true;
+    }
+    if (!m_dev->readSector(m_sector, m_tx + 1)) {
+      m_tx[0] = DATA_ERROR_TOKEN;
+      m_txCount = 1;
+      m_state = IDLE_STATE;
+      return true;
+    }
+    m_sector++;
+    if (m_state == READ_BLOCK_STATE) {
+      m_state = IDLE_STATE;
+    }
+  } else {
+    return false;
+  }
+  uint16_t crc = crc16(m_tx + 1, n);
+  m_tx[0] = DATA_START_SECTOR;
+  m_tx[n + 1] = crc >> 8;
+  m_tx[n + 2] = crc;
+  if (n == 512 && m_maxSck && m_sckSpeed > m_maxSck) {
+    // Simulate a bit error on a marginal link.
+    m_tx[1 + (m_sector & 0XFF)] ^= 0X10;
+  }
+  m_txIndex = 0;
+  m_txCount = n + 3;
+  m_txDelay = m_readLatency;
+  return true;
+}
+//------------------------------------------------------------------------------
+uint8_t SdSpiEmulator::receive() {
+  m_byteCount++;
+  if (!m_selected) {
+    return 0XFF;
+  }
+  if (m_txIndex >= m_txCount && !loadBlock()) {
+    if (m_busy) {
+      m_busy--;
+      return 0;
+    }
+    return 0XFF;
+  }
+  if (m_txDelay) {
+    m_txDelay--;
+    return 0XFF;
+  }
+  return m_tx[m_txIndex++];
+}
+//------------------------------------------------------------------------------
+uint8_t SdSpiEmulator::receive(uint8_t* buf, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    buf[i] = receive();
+  }
+  return 0;
+}
+//------------------------------------------------------------------------------
+// Handle a byte of a data sector for a write.
+void SdSpiEmulator::receiveData(uint8_t data) {
+  m_rx[m_rxCount++] = data;
+  if (m_rxCount < sizeof(m_rx)) {
+    return;
+  }
+  m_rxActive = false;
+  uint8_t token = DATA_RES_ACCEPTED;
+  uint16_t crc = static_cast<uint16_t>(m_rx[512]) << 8 | m_rx[513];
+  if (m_crcOn && crc != crc16(m_rx, 512)) {
+    m_crcErrorCount++;
+    token = DATA_RES_CRC_ERROR;
+  } else if (!m_dev->writeSector(m_sector, m_rx)) {
+    token = DATA_RES_WRITE_ERROR;
+  } else {
+    m_sector++;
+  }
+  m_tx[0] = token;
+  m_txIndex = 0;
+  m_txCount = 1;
+  m_txDelay = 0;
+  m_busy = m_writeBusy;
+  if (m_state == WRITE_SINGLE_STATE || token != DATA_RES_ACCEPTED ||
+      m_sector >= (m_dev->sectorCount() & ~static_cast<uint32_t>(1023))) {
+    m_state = IDLE_STATE;
+  }
+}
+//------------------------------------------------------------------------------
+void SdSpiEmulator::response(uint8_t r1, const uint8_t* extra, uint8_t n) {
+  m_tx[0] = r1;
+  if (n) {
+    memcpy(m_tx + 1, extra, n);
+  }
+  m_txIndex = 0;
+  m_txCount = n + 1;
+  // One fill byte before the response.
+  m_txDelay = 1;
+}
+//------------------------------------------------------------------------------
+void SdSpiEmulator::select(bool value) {
+  if (value != m_selected) {
+    m_selected = value;
+    // Abort a partial command.
+    m_cmdCount = 0;
+  }
+}
+//------------------------------------------------------------------------------
+void SdSpiEmulator::send(uint8_t data) {
+  m_byteCount++;
+  if (!m_selected) {
+    return;
+  }
+  if (m_rxActive) {
+    receiveData(data);
+    return;
+  }
+  if (m_cmdCount == 0) {
+    if (m_state == WRITE_SINGLE_STATE && data == DATA_START_SECTOR) {
+      m_rxActive = true;
+      m_rxCount = 0;
+      return;
+    }
+    if (m_state == WRITE_MULTI_STATE) {
+      if (data == WRITE_MULTIPLE_TOKEN) {
+        m_rxActive = true;
+        m_rxCount = 0;
+        return;
+      }
+      if (data == STOP_TRAN_TOKEN) {
+        m_state = IDLE_STATE;
+        m_txIndex = 0;
+        m_txCount = 0;
+        m_busy = m_writeBusy;
+        return;
+      }
+    }
+    // Start of a command is 01XXXXXX.
+    if ((data & 0XC0) != 0X40) {
+      return;
+    }
+  }
+  m_cmd[m_cmdCount++] = data;
+  if (m_cmdCount == sizeof(m_cmd)) {
+    m_cmdCount = 0;
+    command();
+  }
+}
+//------------------------------------------------------------------------------
+void SdSpiEmulator::send(const uint8_t* buf, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    send(buf[i]);
+  }
+}
+//------------------------------------------------------------------------------
+// Data block follows the response.
+void SdSpiEmulator::setRegister(const uint8_t* reg, uint8_t n) {
+  if (reg != m_reg) {
+    memcpy(m_reg, reg, n);
+  }
+  m_regCount = n;
+  m_state = READ_BLOCK_STATE;
+}
+//------------------------------------------------------------------------------
+void SdSpiEmulator::unlink() {
+  if (m_linked) {
+    for (SdSpiEmulator** p = &emulatorList; *p; p = &(*p)->m_next) {
+      if (*p == this) {
+        *p = m_next;
+        break;
+      }
+    }
+    m_linked = false;
+  }
+}
+#endif  // SPI_DRIVER_SELECT == 3
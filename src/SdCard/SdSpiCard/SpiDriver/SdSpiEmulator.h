@@ -0,0 +1,205 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * \file
+ * \brief SD card SPI protocol emulator.
+ */
+#pragma once
+#include "../../../common/SysCall.h"
+#include "../../../common/FsBlockDeviceInterface.h"
+#include "SdSpiDriver.h"
+#if SPI_DRIVER_SELECT == 3
+/**
+ * \class SdSpiEmulator
+ * \brief Emulated SDHC card behind the SdSpiBaseClass interface.
+ *
+ * The emulator decodes the SPI byte stream sent by SdSpiCard and answers
+ * like an SDHC card.  Sectors are stored in a block device so a RAM or
+ * image file device can back the card.  This allows SdSpiCard to be
+ * tested and benchmarked on a PC without hardware.
+ *
+ * Busy time is counted in SPI bytes since the emulator has no clock.
+ *
+ * Chip select is reported by sdCsWrite().  A weak sdCsWrite() that calls
+ * csWrite() is defined if ENABLE_ARDUINO_FEATURES is zero.
+ */
+class SdSpiEmulator : public SdSpiBaseClass {
+ public:
+  /** Create an emulated card.
+   *
+   * \param[in] dev Block device for card storage.  The card capacity is
+   * the device sector count rounded down to a multiple of 1024.
+   */
+  explicit SdSpiEmulator(FsBlockDeviceInterface* dev) : m_dev(dev) {}
+  ~SdSpiEmulator() { unlink(); }
+  /** Initialize the SPI bus.
+   *
+   * \param[in] config SPI configuration.
+   */
+  void begin(SdSpiConfig config) override;
+  /** Deactivate SPI driver. */
+  void end() override { unlink(); }
+  /** \return true if async receive is enabled by setAsyncReceive(). */
+  bool hasAsyncReceive() override { return m_asyncReceive; }
+  /** Receive a byte.
+   *
+   * \return The byte.
+   */
+  uint8_t receive() override;
+  /** Receive multiple bytes.
+   *
+   * \param[out] buf Buffer to receive the data.
+   * \param[in] count Number of bytes to receive.
+   *
+   * \return Zero for no error or nonzero error code.
+   */
+  uint8_t receive(uint8_t* buf, size_t count) override;
+  /** Send a byte.
+   *
+   * \param[in] data Byte to send
+   */
+  void send(uint8_t data) override;
+  /** Send multiple bytes.
+   *
+   * \param[in] buf Buffer for data to be sent.
+   * \param[in] count Number of bytes to send.
+   */
+  void send(const uint8_t* buf, size_t count) override;
+  /** Save high speed SPISettings after SD initialization.
+   *
+   * \param[in] maxSck Maximum SCK frequency.
+   */
+  void setSckSpeed(uint32_t maxSck) override { m_sckSpeed = maxSck; }
+  //----------------------------------------------------------------------------
+  /** \return Number of SPI bytes transferred. */
+  uint64_t byteCount() const { return m_byteCount; }
+  /** \return Number of commands received. */
+  uint32_t commandCount() const { return m_commandCount; }
+  /** \return Number of CRC errors detected. */
+  uint32_t crcErrorCount() const { return m_crcErrorCount; }
+  /** Clear byte, command, and CRC error counts. */
+  void clearCounts() {
+    m_byteCount = 0;
+    m_commandCount = 0;
+    m_crcErrorCount = 0;
+  }
+  /** \return Last value for ACMD23 SET_WR_BLK_ERASE_COUNT. */
+  uint32_t preEraseCount() const { return m_preEraseCount; }
+  /** \return SCK speed set by SdSpiCard. */
+  uint32_t sckSpeed() const { return m_sckSpeed; }
+  /** Report async receive to SdSpiCard.
+   *
+   * \param[in] enable Use the pipelined multi-sector read path.
+   */
+  void setAsyncReceive(bool enable) { m_asyncReceive = enable; }
+  /** Set busy time for erase.
+   *
+   * \param[in] count Number of busy bytes after CMD38.
+   */
+  void setEraseBusy(uint32_t count) { m_eraseBusy = count; }
+  /** Set number of ACMD41 commands that return idle state.
+   *
+   * \param[in] count Number of idle responses.
+   */
+  void setInitCount(uint8_t count) { m_initCount = count; }
+  /** Set the fastest SCK rate for error free reads.
+   *
+   * \param[in] maxSck Data sent at higher rates is corrupted.  Zero for
+   * no limit.
+   */
+  void setMaxSck(uint32_t maxSck) { m_maxSck = maxSck; }
+  /** Set read access time.
+   *
+   * \param[in] count Number of 0XFF bytes before a data token.
+   */
+  void setReadLatency(uint16_t count) { m_readLatency = count; }
+  /** Set programming time for a write.
+   *
+   * \param[in] count Number of busy bytes after each data sector.
+   */
+  void setWriteBusy(uint32_t count) { m_writeBusy = count; }
+  /** Set chip select level.
+   *
+   * \param[in] pin Chip select pin.
+   * \param[in] level Pin level, true for high.
+   */
+  static void csWrite(SdCsPin_t pin, bool level);
+
+ private:
+  enum State : uint8_t {
+    IDLE_STATE,
+    READ_BLOCK_STATE,
+    READ_MULTI_STATE,
+    WRITE_SINGLE_STATE,
+    WRITE_MULTI_STATE
+  };
+  void command();
+  bool loadBlock();
+  void receiveData(uint8_t data);
+  void response(uint8_t r1, const uint8_t* extra = nullptr, uint8_t n = 0);
+  void select(bool value);
+  void setRegister(const uint8_t* reg, uint8_t n);
+  void unlink();
+
+  FsBlockDeviceInterface* m_dev;
+  SdSpiEmulator* m_next = nullptr;
+  uint64_t m_byteCount = 0;
+  uint32_t m_commandCount = 0;
+  uint32_t m_crcErrorCount = 0;
+  uint32_t m_eraseBusy = 10000;
+  uint32_t m_writeBusy = 100;
+  uint32_t m_busy = 0;
+  uint32_t m_maxSck = 0;
+  uint32_t m_sckSpeed = 0;
+  uint32_t m_sector = 0;
+  uint32_t m_eraseStart = 0;
+  uint32_t m_eraseEnd = 0;
+  uint32_t m_preEraseCount = 0;
+  uint16_t m_readLatency = 10;
+  uint16_t m_rxCount = 0;
+  uint16_t m_txCount = 0;
+  uint16_t m_txIndex = 0;
+  uint16_t m_txDelay = 0;
+  uint8_t m_cmdCount = 0;
+  uint8_t m_initCount = 1;
+  uint8_t m_initLeft = 1;
+  uint8_t m_regCount = 0;
+  SdCsPin_t m_csPin = 0;
+  State m_state = IDLE_STATE;
+  bool m_appCmd = false;
+  bool m_asyncReceive = false;
+  bool m_crcOn = false;
+  bool m_idle = true;
+  bool m_linked = false;
+  bool m_rxActive = false;
+  bool m_selected = true;
+  uint8_t m_cmd[6];
+  uint8_t m_reg[64];
+  // Data token, 512 data bytes, and CRC.
+  uint8_t m_tx[515];
+  // Data and CRC for a write.
+  uint8_t m_rx[514];
+};
+#endif  // SPI_DRIVER_SELECT == 3
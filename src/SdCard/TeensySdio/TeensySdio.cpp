@@ -23,6 +23,7 @@
  * DEALINGS IN THE SOFTWARE.
  */
 #if defined(__MK64FX512__) || defined(__MK66FX1M0__) || defined(__IMXRT1062__)
+#include "../SdBusy.h"
 #include "../SdCardInfo.h"
 #include "TeensySdioCard.h"
 #include "TeensySdioDefs.h"
@@ -122,6 +123,8 @@ const uint32_t ACMD6_XFERTYP = SDHC_XFERTYP_CMDINX(ACMD6) | CMD_RESP_R1;
 const uint32_t ACMD13_XFERTYP =
     SDHC_XFERTYP_CMDINX(ACMD13) | CMD_RESP_R1 | DATA_READ_DMA;
 
+const uint32_t ACMD23_XFERTYP = SDHC_XFERTYP_CMDINX(ACMD23) | CMD_RESP_R1;
+
 const uint32_t ACMD41_XFERTYP = SDHC_XFERTYP_CMDINX(ACMD41) | CMD_RESP_R3;
 
 const uint32_t ACMD51_XFERTYP =
@@ -208,6 +211,9 @@ static cid_t m_cid;
 static csd_t m_csd;
 static scr_t m_scr;
 static sds_t m_sds;
+#if SD_LATENCY_STATS
+static SdLatencyStats m_latencyStats;
+#endif  // SD_LATENCY_STATS
 //==============================================================================
 #define DBG_TRACE           \
   Serial.print("TRACE.");   \
@@ -642,12 +648,23 @@ static bool transferStop() {
 static bool yieldTimeout(bool (*fcn)()) {
   m_busyFcn = fcn;
   uint32_t m = micros();
+  // Only card busy waits sleep.  DMA transfer time is part of the read or
+  // write command so yield but do not sleep.
+  bool cardBusy = fcn == isBusyCMD13 || fcn == isBusyDat;
+  SdBusyWait busyWait(cardBusy ? SD_BUSY_STATS : nullptr);
   while (fcn()) {
     if ((micros() - m) > BUSY_TIMEOUT_MICROS) {
       m_busyFcn = 0;
       return true;
     }
     yield();
+    if (cardBusy) {
+      busyWait.poll();
+#if USE_SD_BUSY_CALLBACK
+    } else if (SdBusy::yieldCallback) {
+      SdBusy::yieldCallback();
+#endif  // USE_SD_BUSY_CALLBACK
+    }
   }
   m_busyFcn = 0;
   return false;  // Caller will set errorCode.
@@ -881,6 +898,10 @@ bool TeensySdioCard::isBusy() {
 //------------------------------------------------------------------------------
 uint32_t TeensySdioCard::kHzSdClk() { return m_sdClkKhz; }
 //------------------------------------------------------------------------------
+#if SD_LATENCY_STATS
+SdLatencyStats* TeensySdioCard::latencyStats() { return &m_latencyStats; }
+#endif  // SD_LATENCY_STATS
+//------------------------------------------------------------------------------
 bool TeensySdioCard::readCID(cid_t* cid) {
   memcpy(cid, &m_cid, sizeof(cid_t));
   return true;
@@ -937,6 +958,7 @@ bool TeensySdioCard::readSDS(sds_t* sds) {
 }
 //------------------------------------------------------------------------------
 bool TeensySdioCard::readSector(Sector_t sector, uint8_t* dst) {
+  SD_LATENCY_TIMER(SdLatencyStats::READ_SINGLE);
   if (m_useDma) {
     if (reinterpret_cast<uintptr_t>(dst) & 3) {
       // Not aligned.
@@ -980,6 +1002,8 @@ bool TeensySdioCard::readSector(Sector_t sector, uint8_t* dst) {
 }
 //------------------------------------------------------------------------------
 bool TeensySdioCard::readSectors(Sector_t sector, uint8_t* dst, size_t n) {
+  SD_LATENCY_TIMER(n == 1 ? SdLatencyStats::READ_SINGLE
+                          : SdLatencyStats::READ_MULTI);
   if (m_useDma) {
     if (reinterpret_cast<uintptr_t>(dst) & 3) {
       for (size_t i = 0; i < n; i++, sector++, dst += 512) {
@@ -1045,6 +1069,10 @@ bool TeensySdioCard::stopTransmission(bool blocking) {
 }
 //------------------------------------------------------------------------------
 bool TeensySdioCard::syncDevice() {
+  if (!m_transferActive && m_curState == IDLE_STATE) {
+    return true;
+  }
+  SD_LATENCY_TIMER(SdLatencyStats::SYNC);
   if (!waitTransferComplete()) {
     return false;
   }
@@ -1088,6 +1116,7 @@ bool TeensySdioCard::writeData(const uint8_t* src) {
 }
 //------------------------------------------------------------------------------
 bool TeensySdioCard::writeSector(Sector_t sector, const uint8_t* src) {
+  SD_LATENCY_TIMER(SdLatencyStats::WRITE_SINGLE);
   if (m_useDma) {
     uint8_t* ptr;
     uint8_t aligned[512];
@@ -1132,6 +1161,13 @@ bool TeensySdioCard::writeSector(Sector_t sector, const uint8_t* src) {
 //------------------------------------------------------------------------------
 bool TeensySdioCard::writeSectors(Sector_t sector, const uint8_t* src,
                                   size_t n) {
+  return writeSectorsPreErase(sector, src, n, 0);
+}
+//------------------------------------------------------------------------------
+bool TeensySdioCard::writeSectorsPreErase(Sector_t sector, const uint8_t* src,
+                                          size_t n, uint32_t eraseCount) {
+  SD_LATENCY_TIMER(n == 1 ? SdLatencyStats::WRITE_SINGLE
+                          : SdLatencyStats::WRITE_MULTI);
   if (m_useDma) {
     uint8_t* ptr = const_cast<uint8_t*>(src);
     if (3 & reinterpret_cast<uintptr_t>(ptr)) {
@@ -1142,10 +1178,26 @@ bool TeensySdioCard::writeSectors(Sector_t sector, const uint8_t* src,
       }
       return true;
     }
+    if (n > 1 && eraseCount > 1) {
+      if (yieldTimeout(isBusyCMD13)) {
+        return sdError(SD_CARD_ERROR_CMD13);
+      }
+      if (!cardAcmd(m_rca, ACMD23_XFERTYP, eraseCount < n ? eraseCount : n)) {
+        return sdError(SD_CARD_ERROR_ACMD23);
+      }
+    }
     if (!rdWrSectors(CMD25_DMA_XFERTYP, sector, ptr, n)) {
       return sdError(SD_CARD_ERROR_CMD25);
     }
   } else {
+    if (eraseCount > 1 &&
+        (m_curState != WRITE_STATE || m_curSector != sector)) {
+      if (!syncDevice() || !writeStart(sector, eraseCount)) {
+        return false;
+      }
+      m_curSector = sector;
+      m_curState = WRITE_STATE;
+    }
     for (size_t i = 0; i < n; i++) {
       if (!writeSector(sector + i, src + i * 512UL)) {
         return false;
@@ -1156,9 +1208,20 @@ bool TeensySdioCard::writeSectors(Sector_t sector, const uint8_t* src,
 }
 //------------------------------------------------------------------------------
 bool TeensySdioCard::writeStart(Sector_t sector) {
+  return writeStart(sector, 0);
+}
+//------------------------------------------------------------------------------
+bool TeensySdioCard::writeStart(Sector_t sector, uint32_t eraseCount) {
   if (yieldTimeout(isBusyCMD13)) {
     return sdError(SD_CARD_ERROR_CMD13);
   }
+  // ACMD23 count is 23 bits.
+  if (eraseCount > 0X7FFFFF) {
+    eraseCount = 0X7FFFFF;
+  }
+  if (eraseCount > 1 && !cardAcmd(m_rca, ACMD23_XFERTYP, eraseCount)) {
+    return sdError(SD_CARD_ERROR_ACMD23);
+  }
   SDHC_PROCTL &= ~SDHC_PROCTL_SABGREQ;
 
 #if defined(__IMXRT1062__)
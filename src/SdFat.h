@@ -32,6 +32,15 @@
 #include "FsLib/FsLib.h"
 #include "SdCard/SdCard.h"
 #include "common/SysCall.h"
+#if HAS_IMAGE_DEVICE
+#include "common/FsImageDevice.h"
+#endif  // HAS_IMAGE_DEVICE
+#if USE_BLOCK_DEVICE_INTERFACE
+#include "common/FsReadCacheDevice.h"
+#include "common/FsStripeDevice.h"
+#include "common/FsTraceDevice.h"
+#include "common/FsWriteCombineDevice.h"
+#endif  // USE_BLOCK_DEVICE_INTERFACE
 #if INCLUDE_SDIOS
 #include "sdios.h"
 #endif  // INCLUDE_SDIOS
@@ -40,6 +49,10 @@
 #define SD_FAT_VERSION 20302
 /** SdFat version as string. */
 #define SD_FAT_VERSION_STR "2.3.2-beta.1"
+#if !ENABLE_ARDUINO_FEATURES && !defined(SS)
+/** Default chip select pin for host builds. */
+#define SS 0
+#endif  // !ENABLE_ARDUINO_FEATURES && !defined(SS)
 //==============================================================================
 /**
  * \class SdBase
@@ -162,21 +175,39 @@ class SdBase : public Vol {
   }
   //----------------------------------------------------------------------------
   /** Format SD card
+   *
+   * The volume's sector cache is used as the format buffer.  Use
+   * format(buf, bufSectors, pr) for multi-sector writes if the card
+   * can't zero the FAT and directories with erase.
    *
    * \param[in] pr Print destination.
    * \return true for success else false.
    */
   bool format(print_t* pr = nullptr) {
-    Fmt fmt;
     uint8_t* mem = Vol::end();
-    if (!mem) {
+    return mem ? format(mem, 1, pr) : false;
+  }
+  //----------------------------------------------------------------------------
+  /** Format SD card with a caller's buffer.
+   *
+   * \param[in] buf Format buffer, aligned for the card's transfers.
+   * \param[in] bufSectors Size of buf in sectors.
+   * \param[in] pr Print destination.
+   * \return true for success else false.
+   */
+  bool format(uint8_t* buf, size_t bufSectors, print_t* pr = nullptr) {
+    // Depends on Vol so it only fails if this function is used.
+    static_assert(FS_SECTOR_SIZE_SHIFT == 9 || sizeof(Vol) == 0,
+                  "SD cards require FS_SECTOR_SIZE_SHIFT 9");
+    Fmt fmt;
+    if (!Vol::end()) {
       return false;
     }
     bool switchSpi = hasDedicatedSpi() && !isDedicatedSpi();
     if (switchSpi && !setDedicatedSpi(true)) {
       return false;
     }
-    bool rtn = fmt.format(card(), mem, pr);
+    bool rtn = fmt.format(card(), buf, pr, bufSectors);
     if (switchSpi && !setDedicatedSpi(false)) {
       return false;
     }
@@ -347,6 +378,9 @@ class SdBase : public Vol {
    * \return true for success or false for failure.
    */
   bool volumeBegin() {
+    // Depends on Vol so it only fails if this function is used.
+    static_assert(FS_SECTOR_SIZE_SHIFT == 9 || sizeof(Vol) == 0,
+                  "SD cards require FS_SECTOR_SIZE_SHIFT 9");
     return Vol::begin(m_card) || Vol::begin(m_card, true, 0);
   }
 #if ENABLE_ARDUINO_SERIAL
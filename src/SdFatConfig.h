@@ -85,17 +85,20 @@
 #define DESTRUCTOR_CLOSES_FILE 0
 #endif  // DESTRUCTOR_CLOSES_FILE
 //------------------------------------------------------------------------------
-/** For Debug - must be one on Arduino */
+/**
+ * Must be one on Arduino.  Set zero to build the library for a host
+ * system such as Linux with PrintBasic replacing Arduino Print.
+ */
 #ifndef ENABLE_ARDUINO_FEATURES
 #define ENABLE_ARDUINO_FEATURES 1
 #endif  // ENABLE_ARDUINO_FEATURES
 /** For Debug - must be one on Arduino */
 #ifndef ENABLE_ARDUINO_SERIAL
-#define ENABLE_ARDUINO_SERIAL 1
+#define ENABLE_ARDUINO_SERIAL ENABLE_ARDUINO_FEATURES
 #endif  // ENABLE_ARDUINO_SERIAL
 /** For Debug - must be one on Arduino */
 #ifndef ENABLE_ARDUINO_STRING
-#define ENABLE_ARDUINO_STRING 1
+#define ENABLE_ARDUINO_STRING ENABLE_ARDUINO_FEATURES
 #endif  // ENABLE_ARDUINO_STRING
 //------------------------------------------------------------------------------
 #if ENABLE_ARDUINO_FEATURES
@@ -158,9 +161,15 @@
  * 2 - An external SPI driver of SoftSpiDriver template class is always used.
  *
  * 3 - An external SPI driver derived from SdSpiBaseClass is always used.
+ *
+ * The default is 3 if ENABLE_ARDUINO_FEATURES is zero.
  */
 #ifndef SPI_DRIVER_SELECT
+#if ENABLE_ARDUINO_FEATURES
 #define SPI_DRIVER_SELECT 0
+#else  // ENABLE_ARDUINO_FEATURES
+#define SPI_DRIVER_SELECT 3
+#endif  // ENABLE_ARDUINO_FEATURES
 #endif  // SPI_DRIVER_SELECT
 /**
  * If USE_SPI_ARRAY_TRANSFER is one and the standard SPI library is
@@ -218,10 +227,92 @@
  *   if (!key.begin(&usbMsc)) {
  *     ... handle FAT/exFAT failure.
  *   }
+ *
+ * The default is one if ENABLE_ARDUINO_FEATURES is zero.
  */
 #ifndef USE_BLOCK_DEVICE_INTERFACE
+#if ENABLE_ARDUINO_FEATURES
 #define USE_BLOCK_DEVICE_INTERFACE 0
+#else  // ENABLE_ARDUINO_FEATURES
+#define USE_BLOCK_DEVICE_INTERFACE 1
+#endif  // ENABLE_ARDUINO_FEATURES
 #endif  // USE_BLOCK_DEVICE_INTERFACE
+/**
+ * Define FS_BLOCK_DEVICE_CLASS to bind FAT and exFAT volumes to one
+ * block device class at compile time.  Sector I/O from the volume caches
+ * is then a direct call instead of a virtual call through
+ * FsBlockDeviceInterface.  Volumes can only be started on that class.
+ *
+ * FS_BLOCK_DEVICE_INCLUDE is an optional header that declares the class.
+ * For example, to bind a Teensy SDIO card:
+ *
+ * #define FS_BLOCK_DEVICE_CLASS SdioCard
+ *
+ * SdioCard sdio;
+ * FsVolume vol;
+ * ...
+ *   sdio.begin(SdioConfig(FIFO_SDIO));
+ *   vol.begin(&sdio);
+ *
+ * Or on a Linux host:
+ *
+ * -DFS_BLOCK_DEVICE_CLASS=FsImageDevice
+ * -DFS_BLOCK_DEVICE_INCLUDE='"FsImageDevice.h"'
+ *
+ * The SdFat, SdExFat and SdFs classes start the volume on an SdCard so
+ * they can only be used if FS_BLOCK_DEVICE_CLASS is SdCard or SdSpiCard
+ * on boards without SDIO.
+ *
+ * FS_BLOCK_DEVICE_CLASS must be a plain class name.  A custom class must
+ * provide the FsBlockDeviceInterface member functions used by volumes and
+ * formatters: isBusy, readSector, readSectors, sectorCount, syncDevice,
+ * writeSector, writeSectors, allocationUnitSectors, writeSectorsPreErase,
+ * zeroSectors and discardSectors.  Deriving from FsBlockDeviceInterface
+ * provides defaults for the last four.
+ *
+ * SdSpiCard and FsImageDevice are final only when they are the bound
+ * class so they can be used as base classes in other builds.
+ */
+// #define FS_BLOCK_DEVICE_CLASS SdioCard
+#ifdef FS_BLOCK_DEVICE_CLASS
+/** Paste two tokens after expanding them. */
+#define FS_BLOCK_DEVICE_CAT(a, b) FS_BLOCK_DEVICE_CAT_(a, b)
+/** Paste two tokens. */
+#define FS_BLOCK_DEVICE_CAT_(a, b) a##b
+/** ID of the bound class or zero if the class has no ID. */
+#define FS_BLOCK_DEVICE_ID \
+  FS_BLOCK_DEVICE_CAT(FS_BLOCK_DEVICE_ID_, FS_BLOCK_DEVICE_CLASS)
+#else  // FS_BLOCK_DEVICE_CLASS
+/** No bound class. */
+#define FS_BLOCK_DEVICE_ID 0
+#endif  // FS_BLOCK_DEVICE_CLASS
+/** ID of SdSpiCard for FS_BLOCK_DEVICE_ID. */
+#define FS_BLOCK_DEVICE_ID_SdSpiCard 1
+/** SdCard is SdSpiCard on boards without SDIO. */
+#define FS_BLOCK_DEVICE_ID_SdCard (HAS_SDIO_CLASS ? 0 : 1)
+/** ID of FsImageDevice for FS_BLOCK_DEVICE_ID. */
+#define FS_BLOCK_DEVICE_ID_FsImageDevice 2
+/**
+ * FS_SECTOR_SIZE_SHIFT is log2 of the logical sector size used by FAT and
+ * exFAT volumes, the volume caches and the formatters.  The default, 9, is
+ * 512 byte sectors.  Set it to 12 for devices with native 4096 byte
+ * sectors, for example USB drives or host image files.
+ *
+ * The block device must transfer sectors of this size.  SD cards have 512
+ * byte sectors so begin(), volumeBegin() and format() of the SdFat,
+ * SdExFat and SdFs classes fail to compile unless FS_SECTOR_SIZE_SHIFT
+ * is 9.
+ *
+ * Each volume cache uses FS_SECTOR_SIZE bytes of RAM.
+ */
+#ifndef FS_SECTOR_SIZE_SHIFT
+#define FS_SECTOR_SIZE_SHIFT 9
+#endif  // FS_SECTOR_SIZE_SHIFT
+#if FS_SECTOR_SIZE_SHIFT < 9 || FS_SECTOR_SIZE_SHIFT > 12
+#error "FS_SECTOR_SIZE_SHIFT must be 9, 10, 11, or 12."
+#endif  // FS_SECTOR_SIZE_SHIFT < 9 || FS_SECTOR_SIZE_SHIFT > 12
+/** Logical sector size in bytes. */
+#define FS_SECTOR_SIZE (1U << FS_SECTOR_SIZE_SHIFT)
 //------------------------------------------------------------------------------
 /**
  * SD_CHIP_SELECT_MODE defines how the functions
@@ -284,6 +375,24 @@ typedef uint8_t SdCsPin_t;
 #if USE_UTF8_LONG_NAMES && !USE_LONG_FILE_NAMES
 #error "USE_UTF8_LONG_NAMES requires USE_LONG_FILE_NAMES to be non-zero."
 #endif  // USE_UTF8_LONG_NAMES && !USE_LONG_FILE_NAMES
+/**
+ * Set USE_UPCASE_PAGE_TABLE nonzero to use a two-level page table for
+ * toUpcase() in place of a binary search of range tables.  Case folding
+ * is used by long name compare and the exFAT name hash.  The table
+ * requires about 7 KB of additional flash.
+ */
+#ifndef USE_UPCASE_PAGE_TABLE
+#define USE_UPCASE_PAGE_TABLE 0
+#endif  // USE_UPCASE_PAGE_TABLE
+//------------------------------------------------------------------------------
+/**
+ * WALK_MAX_DEPTH is the maximum subdirectory depth for walk().  Each level
+ * uses a stack frame of 12 bytes for FAT or 20 bytes for exFAT.  walk() does
+ * not descend into subdirectories below this depth.
+ */
+#ifndef WALK_MAX_DEPTH
+#define WALK_MAX_DEPTH 8
+#endif  // WALK_MAX_DEPTH
 //------------------------------------------------------------------------------
 /**
  * Set MAINTAIN_FREE_CLUSTER_COUNT nonzero to keep the count of free clusters
@@ -294,6 +403,47 @@ typedef uint8_t SdCsPin_t;
 #define MAINTAIN_FREE_CLUSTER_COUNT 0
 #endif  // MAINTAIN_FREE_CLUSTER_COUNT
 //------------------------------------------------------------------------------
+/**
+ * Set USE_DISCARD_FREE_CLUSTERS nonzero to erase clusters freed by remove
+ * and truncate.  This helps the card's garbage collection and keeps write
+ * latency low for loggers that delete old files.
+ *
+ * Freed runs are queued and erased after the FAT or bitmap is written by
+ * sync.  Only whole erase groups of the card are erased.
+ */
+#ifndef USE_DISCARD_FREE_CLUSTERS
+#define USE_DISCARD_FREE_CLUSTERS 0
+#endif  // USE_DISCARD_FREE_CLUSTERS
+/**
+ * Number of freed cluster runs queued for discard.  When the queue is full
+ * the smallest run is dropped.
+ */
+#ifndef DISCARD_QUEUE_SIZE
+#define DISCARD_QUEUE_SIZE 4
+#endif  // DISCARD_QUEUE_SIZE
+//------------------------------------------------------------------------------
+/**
+ * Set USE_FS_STATS nonzero to count cache hits and misses, device sector
+ * transfers, FAT and bitmap operations, directory scans, and file reads
+ * and writes for each volume.  Query the counts with the volume's stats()
+ * function and reset them with clearStats().
+ */
+#ifndef USE_FS_STATS
+#define USE_FS_STATS 0
+#endif  // USE_FS_STATS
+/**
+ * Set USE_FS_FILE_STATS nonzero to also keep counts for each open file.
+ * The counts for a file are the volume counts caused by read(), write()
+ * and sync() calls for the file.  Requires USE_FS_STATS and adds about
+ * 60 bytes to each file object.
+ */
+#ifndef USE_FS_FILE_STATS
+#define USE_FS_FILE_STATS 0
+#endif  // USE_FS_FILE_STATS
+#if USE_FS_FILE_STATS && !USE_FS_STATS
+#error "USE_FS_FILE_STATS requires USE_FS_STATS to be non-zero."
+#endif  // USE_FS_FILE_STATS && !USE_FS_STATS
+//------------------------------------------------------------------------------
 /**
  * Set the default file time stamp when a RTC callback is not used.
  * A valid date and time is required by the FAT/exFAT standard.
@@ -332,10 +482,56 @@ typedef uint8_t SdCsPin_t;
  *
  * Set USE_SD_CRC to 2 to used a larger table driven CRC-CCITT function.  This
  * function is faster for AVR but may be slower for ARM and other processors.
+ *
+ * Set USE_SD_CRC to 3 to use a slice-by-4 table driven CRC-CCITT function.
+ * This function uses 2 KB of tables and is fastest for 32-bit processors.
+ *
+ * Set USE_SD_CRC to 4 to use a CRC-CCITT function defined in the application.
+ * The application must define uint16_t sdCrcCcitt(const uint8_t*, size_t)
+ * for example with a hardware CRC unit.
+ *
+ * See the CrcBench example to compare CRC speed on a board and
+ * extras/CrcBench to check and time each level on a host.
  */
 #ifndef USE_SD_CRC
 #define USE_SD_CRC 0
 #endif  // USE_SD_CRC
+/**
+ * Number of sectors read at each SCK rate when TUNE_SPI_SCK is set in the
+ * SdSpiConfig options.  More reads give more confidence in the selected
+ * rate but make begin() slower.
+ */
+#ifndef SD_SCK_TUNE_READS
+#define SD_SCK_TUNE_READS 8
+#endif  // SD_SCK_TUNE_READS
+//------------------------------------------------------------------------------
+/**
+ * Set USE_SD_BUSY_CALLBACK nonzero to call a function while the card is
+ * busy.  Loops that wait for flash programming, erase, the read start
+ * token and card initialization call SdBusy::yieldCallback or
+ * SdBusy::sleepCallback.
+ *
+ * Use SdBusy::setCallback() to run other tasks during busy time or
+ * SdBusy::setSleepCallback() for an RTOS task delay.
+ */
+#ifndef USE_SD_BUSY_CALLBACK
+#define USE_SD_BUSY_CALLBACK 1
+#endif  // USE_SD_BUSY_CALLBACK
+/**
+ * Maximum sleep in ms requested by the sleep callback.  The sleep time
+ * starts at zero and doubles for each busy poll up to this limit.
+ */
+#ifndef SD_BUSY_MAX_SLEEP_MS
+#define SD_BUSY_MAX_SLEEP_MS 8
+#endif  // SD_BUSY_MAX_SLEEP_MS
+/**
+ * Set SD_LATENCY_STATS nonzero to keep log2 histograms of command latency
+ * for SD cards.  Query them with the card's latencyStats() function.
+ * Uses about 600 bytes of RAM per card.
+ */
+#ifndef SD_LATENCY_STATS
+#define SD_LATENCY_STATS 0
+#endif  // SD_LATENCY_STATS
 //------------------------------------------------------------------------------
 /** If the symbol USE_FCNTL_H is nonzero, open flags for access modes O_RDONLY,
  * O_WRONLY, O_RDWR and the open modifiers O_APPEND, O_CREAT, O_EXCL, O_SYNC
@@ -478,3 +674,13 @@ typedef uint8_t SdCsPin_t;
 /** Default is no SDIO. */
 #define HAS_SDIO_CLASS 0
 #endif  // HAS_SDIO_CLASS
+//------------------------------------------------------------------------------
+#ifndef HAS_IMAGE_DEVICE
+#if defined(__linux__) && !ENABLE_ARDUINO_FEATURES
+/** FsImageDevice for disk image files on Linux host builds. */
+#define HAS_IMAGE_DEVICE 1
+#else  // defined(__linux__) && !ENABLE_ARDUINO_FEATURES
+/** Default is no image device. */
+#define HAS_IMAGE_DEVICE 0
+#endif  // defined(__linux__) && !ENABLE_ARDUINO_FEATURES
+#endif  // HAS_IMAGE_DEVICE
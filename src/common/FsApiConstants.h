@@ -74,6 +74,14 @@ const uint8_t LS_SIZE = 4;
 /** ls() flag for recursive list of subdirectories */
 const uint8_t LS_R = 8;
 
+// return values for walk() callbacks
+/** walk() callback return to continue the walk. */
+const uint8_t WALK_CONTINUE = 0;
+/** walk() callback return to skip the contents of a subdirectory. */
+const uint8_t WALK_SKIP = 1;
+/** walk() callback return to end the walk. */
+const uint8_t WALK_STOP = 2;
+
 // flags for time-stamp
 /** set the file's last access date */
 const uint8_t T_ACCESS = 1;
@@ -24,8 +24,13 @@
  */
 #pragma once
 #include "SdCard/SdCard.h"
+#ifdef FS_BLOCK_DEVICE_INCLUDE
+#include FS_BLOCK_DEVICE_INCLUDE
+#endif  // FS_BLOCK_DEVICE_INCLUDE
 //------------------------------------------------------------------------------
-#if HAS_SDIO_CLASS || USE_BLOCK_DEVICE_INTERFACE
+#if defined(FS_BLOCK_DEVICE_CLASS)
+typedef FS_BLOCK_DEVICE_CLASS FsBlockDevice;
+#elif HAS_SDIO_CLASS || USE_BLOCK_DEVICE_INTERFACE
 typedef FsBlockDeviceInterface FsBlockDevice;
 #else
 typedef SdCard FsBlockDevice;
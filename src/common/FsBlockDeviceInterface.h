@@ -37,8 +37,27 @@ class FsBlockDeviceInterface {
  public:
   virtual ~FsBlockDeviceInterface() {}
 
+  /** \return Allocation unit size in sectors or zero if not known. */
+  virtual uint32_t allocationUnitSectors() { return 0; }
+
   /** end use of device */
   virtual void end() {}
+  /**
+   * Discard sectors that no longer contain file data.
+   *
+   * \param[in] firstSector The address of the first sector in the range.
+   * \param[in] lastSector The address of the last sector in the range.
+   *
+   * \note The contents of discarded sectors is undefined.  The default
+   * does nothing.
+   *
+   * \return true for success or false for failure.
+   */
+  virtual bool discardSectors(Sector_t firstSector, Sector_t lastSector) {
+    (void)firstSector;
+    (void)lastSector;
+    return true;
+  }
   /**
    * Check for FsBlockDevice busy.
    *
@@ -67,6 +86,23 @@ class FsBlockDeviceInterface {
   /** \return device size in sectors. */
   virtual Sector_t sectorCount() = 0;
 
+  /**
+   * Set a range of sectors to zero without writing data, for example
+   * with erase.
+   *
+   * \param[in] firstSector The address of the first sector in the range.
+   * \param[in] lastSector The address of the last sector in the range.
+   *
+   * \note The default returns false and the caller must write zeros.
+   *
+   * \return true if the range was zeroed else false.
+   */
+  virtual bool zeroSectors(Sector_t firstSector, Sector_t lastSector) {
+    (void)firstSector;
+    (void)lastSector;
+    return false;
+  }
+
   /** End multi-sector transfer and go to idle state.
    * \return true for success or false for failure.
    */
@@ -90,4 +126,24 @@ class FsBlockDeviceInterface {
    * \return true for success or false for failure.
    */
   virtual bool writeSectors(Sector_t sector, const uint8_t* src, size_t ns) = 0;
+
+  /**
+   * Write multiple sectors with a hint for pre-erase.
+   *
+   * \param[in] sector Logical sector to be written.
+   * \param[in] src Pointer to the location of the data to be written.
+   * \param[in] ns Number of sectors to be written.
+   * \param[in] eraseCount Number of sectors, starting at sector, that will
+   * be written by this and following sequential writes.
+   *
+   * \note Sectors in the hinted range that are not written may be erased.
+   * The default ignores the hint.
+   *
+   * \return true for success or false for failure.
+   */
+  virtual bool writeSectorsPreErase(Sector_t sector, const uint8_t* src,
+                                    size_t ns, uint32_t eraseCount) {
+    (void)eraseCount;
+    return writeSectors(sector, src, ns);
+  }
 };
@@ -38,6 +38,7 @@ uint8_t* FsCache::prepare(Sector_t sector, uint8_t option) {
       goto fail;
     }
     if (!(option & CACHE_OPTION_NO_READ)) {
+      FS_STATS_ADD(m_stats, cacheMisses, 1);
       if (!m_blockDev->readSector(sector, m_buffer)) {
         DBG_FAIL_MACRO;
         goto fail;
@@ -45,6 +46,8 @@ uint8_t* FsCache::prepare(Sector_t sector, uint8_t option) {
     }
     m_status = 0;
     m_sector = sector;
+  } else {
+    FS_STATS_ADD(m_stats, cacheHits, 1);
   }
   m_status |= option & CACHE_STATUS_MASK;
   return m_buffer;
@@ -55,12 +58,14 @@ fail:
 //------------------------------------------------------------------------------
 bool FsCache::sync() {
   if (m_status & CACHE_STATUS_DIRTY) {
+    FS_STATS_ADD(m_stats, cacheWrites, 1);
     if (!m_blockDev->writeSector(m_sector, m_buffer)) {
       DBG_FAIL_MACRO;
       goto fail;
     }
     // mirror second FAT
     if (m_status & CACHE_STATUS_MIRROR_FAT) {
+      FS_STATS_ADD(m_stats, cacheWrites, 1);
       if (!m_blockDev->writeSector(m_sector + m_mirrorOffset, m_buffer)) {
         DBG_FAIL_MACRO;
         goto fail;
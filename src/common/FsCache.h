@@ -28,6 +28,7 @@
  * \brief Common cache code for exFAT and FAT.
  */
 #include "FsBlockDevice.h"
+#include "FsStats.h"
 #include "SysCall.h"
 /**
  * \class FsCache
@@ -65,9 +66,11 @@ class FsCache {
    */
   bool cacheSafeRead(Sector_t sector, uint8_t* dst) {
     if (isCached(sector)) {
-      memcpy(dst, m_buffer, 512);
+      memcpy(dst, m_buffer, FS_SECTOR_SIZE);
       return true;
     }
+    FS_STATS_ADD(m_stats, deviceReads, 1);
+    FS_STATS_ADD(m_stats, deviceReadSectors, 1);
     return m_blockDev->readSector(sector, dst);
   }
   /**
@@ -82,6 +85,8 @@ class FsCache {
     if (isCached(sector, count) && !sync()) {
       return false;
     }
+    FS_STATS_ADD(m_stats, deviceReads, 1);
+    FS_STATS_ADD(m_stats, deviceReadSectors, count);
     return m_blockDev->readSectors(sector, dst, count);
   }
   /**
@@ -95,6 +100,8 @@ class FsCache {
     if (isCached(sector)) {
       invalidate();
     }
+    FS_STATS_ADD(m_stats, deviceWrites, 1);
+    FS_STATS_ADD(m_stats, deviceWriteSectors, 1);
     return m_blockDev->writeSector(sector, src);
   }
   /**
@@ -109,8 +116,28 @@ class FsCache {
     if (isCached(sector, count)) {
       invalidate();
     }
+    FS_STATS_ADD(m_stats, deviceWrites, 1);
+    FS_STATS_ADD(m_stats, deviceWriteSectors, count);
     return m_blockDev->writeSectors(sector, src, count);
   }
+  /**
+   * Cache safe write of multiple sectors with a hint for pre-erase.
+   *
+   * \param[in] sector Logical sector to be written.
+   * \param[in] src Pointer to the location of the data to be written.
+   * \param[in] count Number of sectors to be written.
+   * \param[in] eraseCount Number of sectors that will be written.
+   * \return true for success or false for failure.
+   */
+  bool cacheSafeWrite(Sector_t sector, const uint8_t* src, size_t count,
+                      uint32_t eraseCount) {
+    if (isCached(sector, count)) {
+      invalidate();
+    }
+    FS_STATS_ADD(m_stats, deviceWrites, 1);
+    FS_STATS_ADD(m_stats, deviceWriteSectors, count);
+    return m_blockDev->writeSectorsPreErase(sector, src, count, eraseCount);
+  }
   /** \return Clear the cache and returns a pointer to the cache. */
   uint8_t* clear() {
     if (isDirty() && !sync()) {
@@ -160,6 +187,12 @@ class FsCache {
    * \param[in] offset Sector offset to second FAT.
    */
   void setMirrorOffset(uint32_t offset) { m_mirrorOffset = offset; }
+#if USE_FS_STATS
+  /** Set the counters for this cache.
+   * \param[in] stats Counters for the volume.
+   */
+  void setStats(FsStats* stats) { m_stats = stats; }
+#endif  // USE_FS_STATS
   /** Write current sector if dirty.
    * \return true for success or false for failure.
    */
@@ -170,5 +203,8 @@ class FsCache {
   FsBlockDevice* m_blockDev;
   Sector_t m_sector;
   uint32_t m_mirrorOffset;
-  uint8_t m_buffer[512] __attribute__((aligned(4)));
+#if USE_FS_STATS
+  FsStats* m_stats = nullptr;
+#endif  // USE_FS_STATS
+  uint8_t m_buffer[FS_SECTOR_SIZE] __attribute__((aligned(4)));
 };
@@ -0,0 +1,94 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#define DBG_FILE "FsDiscard.cpp"
+#include "FsDiscard.h"
+
+#include "DebugMacros.h"
+//------------------------------------------------------------------------------
+void FsDiscard::add(Cluster_t cluster, uint32_t count) {
+  Run* r;
+  // Queued runs are never adjacent so at most one merges on each side.
+  for (uint8_t i = 0; i < m_count;) {
+    r = &m_run[i];
+    if ((r->cluster + r->count) == cluster) {
+      cluster = r->cluster;
+    } else if ((cluster + count) != r->cluster) {
+      i++;
+      continue;
+    }
+    count += r->count;
+    *r = m_run[--m_count];
+  }
+  if (m_count < DISCARD_QUEUE_SIZE) {
+    r = &m_run[m_count++];
+  } else {
+    // Queue is full.  Replace the smallest run if this run is larger.
+    r = &m_run[0];
+    for (uint8_t i = 1; i < m_count; i++) {
+      if (m_run[i].count < r->count) {
+        r = &m_run[i];
+      }
+    }
+    if (count <= r->count) {
+      return;
+    }
+  }
+  r->cluster = cluster;
+  r->count = count;
+}
+//------------------------------------------------------------------------------
+void FsDiscard::cancel(Cluster_t cluster, uint32_t count) {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < m_count; i++) {
+    Run* r = &m_run[i];
+    if (cluster < (r->cluster + r->count) && r->cluster < (cluster + count)) {
+      continue;
+    }
+    m_run[n++] = *r;
+  }
+  m_count = n;
+}
+//------------------------------------------------------------------------------
+bool FsDiscard::flush(FsBlockDevice* dev, Sector_t heapStart, uint8_t shift) {
+  while (m_count) {
+    Run* r = &m_run[--m_count];
+    Sector_t first = heapStart + ((r->cluster - 2) << shift);
+    Sector_t end = first + (r->count << shift);
+    if (m_unitSectors > 1) {
+      // Trim to whole allocation units.
+      first += (m_unitSectors - first % m_unitSectors) % m_unitSectors;
+      end -= end % m_unitSectors;
+    }
+    if (first < end && !dev->discardSectors(first, end - 1)) {
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+  }
+  return true;
+
+fail:
+  m_count = 0;
+  return false;
+}
@@ -0,0 +1,89 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+/**
+ * \file
+ * \brief Queue of freed clusters to be discarded.
+ */
+#include "FsBlockDevice.h"
+#include "FsStructs.h"
+#include "SysCall.h"
+/**
+ * \class FsDiscard
+ * \brief Runs of freed clusters waiting to be discarded.
+ *
+ * Runs are discarded by flush() after the FAT or bitmap that frees them
+ * has been written.  A run is dropped if any of its clusters is allocated
+ * before flush().  Discard is only a hint to the card so runs that do
+ * not fit in the queue are dropped rather than forcing a sync.
+ *
+ * If the device reports an allocation unit, only whole allocation units
+ * are discarded.  Erasing a few clusters costs an erase on every sync
+ * and gains little since cards manage flash by allocation unit.
+ */
+class FsDiscard {
+ public:
+  /** Add a run of freed clusters.
+   *
+   * The run is merged with queued runs on either side.  If the queue is
+   * full, the smallest run is dropped.
+   *
+   * \param[in] cluster First cluster of the run.
+   * \param[in] count Number of clusters in the run.
+   */
+  void add(Cluster_t cluster, uint32_t count);
+  /** Drop runs that overlap allocated clusters.
+   *
+   * \param[in] cluster First allocated cluster.
+   * \param[in] count Number of allocated clusters.
+   */
+  void cancel(Cluster_t cluster, uint32_t count);
+  /** Discard all queued runs.
+   *
+   * \param[in] dev Block device for the volume.
+   * \param[in] heapStart Sector for cluster two.
+   * \param[in] shift Cluster to sector shift.
+   * \return true for success or false for failure.
+   */
+  bool flush(FsBlockDevice* dev, Sector_t heapStart, uint8_t shift);
+  /** Remove all runs.
+   *
+   * \param[in] unitSectors Allocation unit size in sectors, zero or one
+   * to discard runs of any size.
+   */
+  void init(uint32_t unitSectors) {
+    m_count = 0;
+    m_unitSectors = unitSectors;
+  }
+
+ private:
+  struct Run {
+    Cluster_t cluster;
+    uint32_t count;
+  };
+  uint32_t m_unitSectors = 0;
+  uint8_t m_count = 0;
+  Run m_run[DISCARD_QUEUE_SIZE];
+};
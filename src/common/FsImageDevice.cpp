@@ -0,0 +1,209 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#define DBG_FILE "FsImageDevice.cpp"
+#include "FsImageDevice.h"
+#if HAS_IMAGE_DEVICE
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "DebugMacros.h"
+//------------------------------------------------------------------------------
+static off_t sectorOffset(Sector_t sector) {
+  return static_cast<off_t>(sector) << FS_SECTOR_SIZE_SHIFT;
+}
+//------------------------------------------------------------------------------
+bool FsImageDevice::begin(const char* path, uint8_t options) {
+  int flags = options & IMAGE_OPT_READ_ONLY ? O_RDONLY : O_RDWR;
+  end();
+  return open(::open(path, flags | O_CLOEXEC), options);
+}
+//------------------------------------------------------------------------------
+bool FsImageDevice::create(const char* path, Sector_t sectorCount,
+                           uint8_t options) {
+  int fd;
+  end();
+  if (options & IMAGE_OPT_READ_ONLY) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+  if (fd < 0) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  if (ftruncate(fd, sectorOffset(sectorCount))) {
+    DBG_FAIL_MACRO;
+    close(fd);
+    goto fail;
+  }
+  return open(fd, options);
+
+fail:
+  return false;
+}
+//------------------------------------------------------------------------------
+bool FsImageDevice::discardSectors(Sector_t firstSector, Sector_t lastSector) {
+  // Discard is a hint so ignore file systems without hole support.
+  return punchHole(firstSector, lastSector) || errno == EOPNOTSUPP;
+}
+//------------------------------------------------------------------------------
+void FsImageDevice::end() {
+  if (m_map) {
+    munmap(m_map, sectorOffset(m_sectorCount));
+    m_map = nullptr;
+  }
+  if (m_fd >= 0) {
+    close(m_fd);
+    m_fd = -1;
+  }
+  m_sectorCount = 0;
+}
+//------------------------------------------------------------------------------
+bool FsImageDevice::open(int fd, uint8_t options) {
+  struct stat st;
+  m_fd = fd;
+  m_options = options;
+  if (fd < 0 || fstat(fd, &st)) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  if ((st.st_size >> FS_SECTOR_SIZE_SHIFT) > 0XFFFFFFFF) {
+    m_sectorCount = 0XFFFFFFFF;
+  } else {
+    m_sectorCount = st.st_size >> FS_SECTOR_SIZE_SHIFT;
+  }
+  if (options & IMAGE_OPT_MMAP) {
+    int prot = options & IMAGE_OPT_READ_ONLY ? PROT_READ
+                                             : PROT_READ | PROT_WRITE;
+    void* map =
+        mmap(nullptr, sectorOffset(m_sectorCount), prot, MAP_SHARED, fd, 0);
+    if (m_sectorCount == 0 || map == MAP_FAILED) {
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+    m_map = static_cast<uint8_t*>(map);
+  }
+  return true;
+
+fail:
+  end();
+  return false;
+}
+//------------------------------------------------------------------------------
+bool FsImageDevice::punchHole(Sector_t firstSector, Sector_t lastSector) {
+  if (lastSector < firstSector ||
+      !validRange(firstSector, lastSector - firstSector + 1) ||
+      (m_options & IMAGE_OPT_READ_ONLY)) {
+    errno = EINVAL;
+    return false;
+  }
+  return fallocate(m_fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                   sectorOffset(firstSector),
+                   sectorOffset(lastSector - firstSector + 1)) == 0;
+}
+//------------------------------------------------------------------------------
+bool FsImageDevice::readSectors(Sector_t sector, uint8_t* dst, size_t ns) {
+  size_t n = ns << FS_SECTOR_SIZE_SHIFT;
+  off_t offset = sectorOffset(sector);
+  if (!validRange(sector, ns)) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  if (m_map) {
+    memcpy(dst, m_map + offset, n);
+    return true;
+  }
+  while (n) {
+    ssize_t rtn = pread(m_fd, dst, n, offset);
+    if (rtn <= 0) {
+      if (rtn < 0 && errno == EINTR) {
+        continue;
+      }
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+    dst += rtn;
+    offset += rtn;
+    n -= rtn;
+  }
+  return true;
+
+fail:
+  return false;
+}
+//------------------------------------------------------------------------------
+bool FsImageDevice::syncDevice() {
+  if (m_fd < 0) {
+    return false;
+  }
+  if (!(m_options & IMAGE_OPT_SYNC) || (m_options & IMAGE_OPT_READ_ONLY)) {
+    return true;
+  }
+  if (m_map && msync(m_map, sectorOffset(m_sectorCount), MS_SYNC)) {
+    DBG_FAIL_MACRO;
+    return false;
+  }
+  return fdatasync(m_fd) == 0;
+}
+//------------------------------------------------------------------------------
+bool FsImageDevice::writeSectors(Sector_t sector, const uint8_t* src,
+                                 size_t ns) {
+  size_t n = ns << FS_SECTOR_SIZE_SHIFT;
+  off_t offset = sectorOffset(sector);
+  if (!validRange(sector, ns) || (m_options & IMAGE_OPT_READ_ONLY)) {
+    DBG_FAIL_MACRO;
+    goto fail;
+  }
+  if (m_map) {
+    memcpy(m_map + offset, src, n);
+    return true;
+  }
+  while (n) {
+    ssize_t rtn = pwrite(m_fd, src, n, offset);
+    if (rtn <= 0) {
+      if (rtn < 0 && errno == EINTR) {
+        continue;
+      }
+      DBG_FAIL_MACRO;
+      goto fail;
+    }
+    src += rtn;
+    offset += rtn;
+    n -= rtn;
+  }
+  return true;
+
+fail:
+  return false;
+}
+//------------------------------------------------------------------------------
+bool FsImageDevice::zeroSectors(Sector_t firstSector, Sector_t lastSector) {
+  return punchHole(firstSector, lastSector);
+}
+#endif  // HAS_IMAGE_DEVICE
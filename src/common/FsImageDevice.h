@@ -0,0 +1,155 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+/**
+ * \file
+ * \brief FsImageDevice class for disk image files on a Linux host.
+ */
+#include "SysCall.h"
+#if HAS_IMAGE_DEVICE
+#include "FsBlockDeviceInterface.h"
+#if FS_BLOCK_DEVICE_ID == FS_BLOCK_DEVICE_ID_FsImageDevice
+/** Calls through a bound FsBlockDevice are direct if FsImageDevice is final. */
+#define FS_IMAGE_DEVICE_FINAL final
+#else  // FS_BLOCK_DEVICE_ID
+/** FsImageDevice is not final unless it is the bound class. */
+#define FS_IMAGE_DEVICE_FINAL
+#endif  // FS_BLOCK_DEVICE_ID
+/**
+ * \class FsImageDevice
+ * \brief Block device for a disk image file on a Linux host.
+ *
+ * Sectors are read and written with pread() and pwrite().  A multi-sector
+ * transfer is a single system call.  With IMAGE_OPT_MMAP the image is
+ * mapped and transfers are memory copies with no system call.
+ *
+ * Build the library for a host by defining ENABLE_ARDUINO_FEATURES zero
+ * and compiling the files in src/common, src/FatLib, src/ExFatLib and
+ * src/FsLib with the application.
+ */
+class FsImageDevice FS_IMAGE_DEVICE_FINAL : public FsBlockDeviceInterface {
+ public:
+  /** Map the image and use memory copies for transfers. */
+  static const uint8_t IMAGE_OPT_MMAP = 1;
+  /** Open the image read only. */
+  static const uint8_t IMAGE_OPT_READ_ONLY = 2;
+  /** syncDevice() flushes data to the storage under the image. */
+  static const uint8_t IMAGE_OPT_SYNC = 4;
+
+  FsImageDevice() {}
+  ~FsImageDevice() { end(); }
+  /** Open an existing image file.
+   *
+   * \param[in] path Path for the image file.
+   * \param[in] options IMAGE_OPT_ options.
+   * \return true for success or false for failure.
+   */
+  bool begin(const char* path, uint8_t options = 0);
+  /** Create or truncate an image file and open it.
+   *
+   * \param[in] path Path for the image file.
+   * \param[in] sectorCount Size of the image in sectors.
+   * \param[in] options IMAGE_OPT_ options.
+   * \return true for success or false for failure.
+   */
+  bool create(const char* path, Sector_t sectorCount, uint8_t options = 0);
+  /**
+   * Punch a hole in the image file for discarded sectors.
+   *
+   * \param[in] firstSector The address of the first sector in the range.
+   * \param[in] lastSector The address of the last sector in the range.
+   * \return true for success or false for failure.
+   */
+  bool discardSectors(Sector_t firstSector, Sector_t lastSector) override;
+  /** Close the image file. */
+  void end() override;
+  /** \return always false. */
+  bool isBusy() override { return false; }
+  /** \return true if an image is open. */
+  bool isOpen() const { return m_fd >= 0; }
+  /**
+   * Read a sector.
+   *
+   * \param[in] sector Logical sector to be read.
+   * \param[out] dst Pointer to the location that will receive the data.
+   * \return true for success or false for failure.
+   */
+  bool readSector(Sector_t sector, uint8_t* dst) override {
+    return readSectors(sector, dst, 1);
+  }
+  /**
+   * Read multiple sectors.
+   *
+   * \param[in] sector Logical sector to be read.
+   * \param[in] ns Number of sectors to be read.
+   * \param[out] dst Pointer to the location that will receive the data.
+   * \return true for success or false for failure.
+   */
+  bool readSectors(Sector_t sector, uint8_t* dst, size_t ns) override;
+  /** \return device size in sectors. */
+  Sector_t sectorCount() override { return m_sectorCount; }
+  /** \return true for success or false for failure. */
+  bool syncDevice() override;
+  /**
+   * Writes a sector.
+   *
+   * \param[in] sector Logical sector to be written.
+   * \param[in] src Pointer to the location of the data to be written.
+   * \return true for success or false for failure.
+   */
+  bool writeSector(Sector_t sector, const uint8_t* src) override {
+    return writeSectors(sector, src, 1);
+  }
+  /**
+   * Write multiple sectors.
+   *
+   * \param[in] sector Logical sector to be written.
+   * \param[in] src Pointer to the location of the data to be written.
+   * \param[in] ns Number of sectors to be written.
+   * \return true for success or false for failure.
+   */
+  bool writeSectors(Sector_t sector, const uint8_t* src, size_t ns) override;
+  /**
+   * Set a range of sectors to zero by deallocating file space.
+   *
+   * \param[in] firstSector The address of the first sector in the range.
+   * \param[in] lastSector The address of the last sector in the range.
+   * \return true if the range was zeroed else false.
+   */
+  bool zeroSectors(Sector_t firstSector, Sector_t lastSector) override;
+
+ private:
+  bool open(int fd, uint8_t options);
+  bool punchHole(Sector_t firstSector, Sector_t lastSector);
+  bool validRange(Sector_t sector, size_t ns) const {
+    return sector < m_sectorCount && ns <= (m_sectorCount - sector);
+  }
+
+  int m_fd = -1;
+  uint8_t m_options = 0;
+  uint8_t* m_map = nullptr;
+  Sector_t m_sectorCount = 0;
+};
+#endif  // HAS_IMAGE_DEVICE
@@ -33,6 +33,9 @@ uint16_t FsName::get16() {
     ls = 0;
   } else if (next >= end) {
     rtn = 0;
+  } else if ((*next & 0X80) == 0) {
+    // ASCII needs no decode.
+    rtn = *next++;
   } else {
     uint32_t cp;
     const char* ptr = FsUtf::mbToCp(next, end, &cp);
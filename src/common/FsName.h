@@ -45,6 +45,8 @@ class FsName {
 #if !USE_UTF8_LONG_NAMES
   /** \return true if at end. */
   bool atEnd() { return next == end; }
+  /** \return true if four chars remain for a block compare. */
+  bool has4() { return (end - next) >= 4; }
   /** Reset to start of LFN. */
   void reset() { next = begin; }
   /** \return next char of LFN. */
@@ -54,6 +56,7 @@ class FsName {
 #else   // !USE_UTF8_LONG_NAMES
   uint16_t ls = 0;
   bool atEnd() { return !ls && next == end; }
+  bool has4() { return !ls && (end - next) >= 4; }
   void reset() {
     next = begin;
     ls = 0;  // lowSurrogate
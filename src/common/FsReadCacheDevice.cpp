@@ -0,0 +1,208 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#define DBG_FILE "FsReadCacheDevice.cpp"
+#include "FsReadCacheDevice.h"
+
+#include <string.h>
+
+#include "DebugMacros.h"
+//------------------------------------------------------------------------------
+bool FsReadCacheDevice::begin(FsBlockDeviceInterface* dev,
+                              FsReadCacheSlot* slots, uint8_t* pool,
+                              size_t count) {
+  m_dev = dev;
+  m_count = 0;
+  if (count >= NIL) {
+    DBG_FAIL_MACRO;
+    return false;
+  }
+  m_slots = slots;
+  m_pool = pool;
+  m_count = count;
+  clearCounts();
+  invalidate();
+  return true;
+}
+//------------------------------------------------------------------------------
+uint16_t FsReadCacheDevice::find(Sector_t sector) const {
+  uint16_t i = m_slots[bucket(sector)].hashHead;
+  while (i != NIL && m_slots[i].sector != sector) {
+    i = m_slots[i].hashNext;
+  }
+  return i;
+}
+//------------------------------------------------------------------------------
+void FsReadCacheDevice::hashUnlink(uint16_t i) {
+  uint16_t* p = &m_slots[bucket(m_slots[i].sector)].hashHead;
+  while (*p != i) {
+    p = &m_slots[*p].hashNext;
+  }
+  *p = m_slots[i].hashNext;
+  m_slots[i].sector = INVALID_SECTOR;
+}
+//------------------------------------------------------------------------------
+void FsReadCacheDevice::insert(Sector_t sector, const uint8_t* src) {
+  // Reuse the least recently used slot.
+  uint16_t i = m_lruTail;
+  if (m_slots[i].sector != INVALID_SECTOR) {
+    hashUnlink(i);
+  }
+  uint16_t b = bucket(sector);
+  m_slots[i].sector = sector;
+  m_slots[i].hashNext = m_slots[b].hashHead;
+  m_slots[b].hashHead = i;
+  memcpy(data(i), src, FS_SECTOR_SIZE);
+  lruUnlink(i);
+  lruPushFront(i);
+}
+//------------------------------------------------------------------------------
+void FsReadCacheDevice::invalidate() {
+  m_lruHead = NIL;
+  m_lruTail = NIL;
+  for (uint16_t i = 0; i < m_count; i++) {
+    m_slots[i].sector = INVALID_SECTOR;
+    m_slots[i].hashHead = NIL;
+    lruPushBack(i);
+  }
+}
+//------------------------------------------------------------------------------
+void FsReadCacheDevice::invalidate(Sector_t firstSector, Sector_t lastSector) {
+  if ((lastSector - firstSector) < m_count) {
+    for (Sector_t sector = firstSector; sector <= lastSector; sector++) {
+      uint16_t i = find(sector);
+      if (i != NIL) {
+        hashUnlink(i);
+        lruUnlink(i);
+        lruPushBack(i);
+      }
+    }
+  } else {
+    // Range is larger than the pool so check each slot.
+    for (uint16_t i = 0; i < m_count; i++) {
+      Sector_t sector = m_slots[i].sector;
+      if (sector != INVALID_SECTOR && firstSector <= sector &&
+          sector <= lastSector) {
+        hashUnlink(i);
+        lruUnlink(i);
+        lruPushBack(i);
+      }
+    }
+  }
+}
+//------------------------------------------------------------------------------
+void FsReadCacheDevice::lruPushBack(uint16_t i) {
+  m_slots[i].lruPrev = m_lruTail;
+  m_slots[i].lruNext = NIL;
+  if (m_lruTail != NIL) {
+    m_slots[m_lruTail].lruNext = i;
+  } else {
+    m_lruHead = i;
+  }
+  m_lruTail = i;
+}
+//------------------------------------------------------------------------------
+void FsReadCacheDevice::lruPushFront(uint16_t i) {
+  m_slots[i].lruPrev = NIL;
+  m_slots[i].lruNext = m_lruHead;
+  if (m_lruHead != NIL) {
+    m_slots[m_lruHead].lruPrev = i;
+  } else {
+    m_lruTail = i;
+  }
+  m_lruHead = i;
+}
+//------------------------------------------------------------------------------
+void FsReadCacheDevice::lruUnlink(uint16_t i) {
+  uint16_t prev = m_slots[i].lruPrev;
+  uint16_t next = m_slots[i].lruNext;
+  if (prev != NIL) {
+    m_slots[prev].lruNext = next;
+  } else {
+    m_lruHead = next;
+  }
+  if (next != NIL) {
+    m_slots[next].lruPrev = prev;
+  } else {
+    m_lruTail = prev;
+  }
+}
+//------------------------------------------------------------------------------
+bool FsReadCacheDevice::readSector(Sector_t sector, uint8_t* dst) {
+  uint16_t i = m_count ? find(sector) : NIL;
+  if (i != NIL) {
+    memcpy(dst, data(i), FS_SECTOR_SIZE);
+    lruUnlink(i);
+    lruPushFront(i);
+    m_hitCount++;
+    return true;
+  }
+  if (!m_dev->readSector(sector, dst)) {
+    DBG_FAIL_MACRO;
+    return false;
+  }
+  m_missCount++;
+  if (m_count) {
+    insert(sector, dst);
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+bool FsReadCacheDevice::readSectors(Sector_t sector, uint8_t* dst,
+                                    size_t ns) {
+  bool keep = ns <= m_count / 2;
+  size_t i = 0;
+  if (m_count == 0) {
+    m_missCount += ns;
+    return m_dev->readSectors(sector, dst, ns);
+  }
+  while (i < ns) {
+    uint16_t k = find(sector + i);
+    if (k != NIL) {
+      memcpy(dst + FS_SECTOR_SIZE * i, data(k), FS_SECTOR_SIZE);
+      lruUnlink(k);
+      lruPushFront(k);
+      m_hitCount++;
+      i++;
+      continue;
+    }
+    // Read a run of adjacent misses with one command.
+    size_t n = 1;
+    while ((i + n) < ns && find(sector + i + n) == NIL) {
+      n++;
+    }
+    uint8_t* p = dst + FS_SECTOR_SIZE * i;
+    if (n == 1 ? !m_dev->readSector(sector + i, p)
+               : !m_dev->readSectors(sector + i, p, n)) {
+      DBG_FAIL_MACRO;
+      return false;
+    }
+    m_missCount += n;
+    for (size_t j = 0; keep && j < n; j++) {
+      insert(sector + i + j, p + FS_SECTOR_SIZE * j);
+    }
+    i += n;
+  }
+  return true;
+}
@@ -0,0 +1,153 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+/**
+ * \file
+ * \brief FsReadCacheDevice class caches sectors read from a block device.
+ */
+#include "SysCall.h"
+// Include order is important.
+#include "FsBlockDeviceInterface.h"
+/**
+ * \struct FsReadCacheSlot
+ * \brief State for one sector of the cache pool.
+ */
+struct FsReadCacheSlot {
+  /** Cached sector or FsReadCacheDevice::INVALID_SECTOR. */
+  Sector_t sector;
+  /** First slot of the hash chain for bucket with this index. */
+  uint16_t hashHead;
+  /** Next slot in this slot's hash chain. */
+  uint16_t hashNext;
+  /** Next more recently used slot. */
+  uint16_t lruPrev;
+  /** Next less recently used slot. */
+  uint16_t lruNext;
+};
+/**
+ * \class FsReadCacheDevice
+ * \brief Pass through block device with an LRU pool of read sectors.
+ *
+ * Sectors returned by reads are kept in a pool supplied by the caller.
+ * Adjacent sectors that miss are read with one multi-sector command.
+ * Writes go straight to the device and remove the written sectors from
+ * the pool.  Reads longer than half the pool are not added to the pool
+ * so a long sequential read does not flush it.
+ *
+ * Use with USE_BLOCK_DEVICE_INTERFACE nonzero:
+ *
+ * FsReadCacheSlot slots[32];
+ * uint8_t pool[32*FS_SECTOR_SIZE];
+ * FsReadCacheDevice cache;
+ * ...
+ *   cache.begin(&card, slots, pool, 32);
+ *   volume.begin(&cache);
+ */
+class FsReadCacheDevice : public FsBlockDeviceInterface {
+ public:
+  /** Sector number for a free slot. */
+  static const Sector_t INVALID_SECTOR = ~static_cast<Sector_t>(0);
+  /** Start caching a device.
+   *
+   * \param[in] dev Device to be cached.
+   * \param[in] slots Array of count slots.
+   * \param[in] pool Buffer for count sectors, for example in PSRAM.
+   * \param[in] count Number of sectors in the pool, at most 65535.
+   * \return false if count is too large.
+   */
+  bool begin(FsBlockDeviceInterface* dev, FsReadCacheSlot* slots,
+             uint8_t* pool, size_t count);
+  /** Set the hit and miss counts to zero. */
+  void clearCounts() {
+    m_hitCount = 0;
+    m_missCount = 0;
+  }
+  /** \return Number of sectors read from the pool. */
+  uint32_t hitCount() const { return m_hitCount; }
+  /** Remove all sectors from the pool.  Call this if the device is
+   * written without using this object.
+   */
+  void invalidate();
+  /** \return Number of sectors read from the device. */
+  uint32_t missCount() const { return m_missCount; }
+
+  uint32_t allocationUnitSectors() override {
+    return m_dev->allocationUnitSectors();
+  }
+  bool discardSectors(Sector_t firstSector, Sector_t lastSector) override {
+    invalidate(firstSector, lastSector);
+    return m_dev->discardSectors(firstSector, lastSector);
+  }
+  void end() override {
+    invalidate();
+    m_dev->end();
+  }
+  bool isBusy() override { return m_dev->isBusy(); }
+  bool readSector(Sector_t sector, uint8_t* dst) override;
+  bool readSectors(Sector_t sector, uint8_t* dst, size_t ns) override;
+  Sector_t sectorCount() override { return m_dev->sectorCount(); }
+  bool syncDevice() override { return m_dev->syncDevice(); }
+  bool writeSector(Sector_t sector, const uint8_t* src) override {
+    invalidate(sector, sector);
+    return m_dev->writeSector(sector, src);
+  }
+  bool writeSectors(Sector_t sector, const uint8_t* src, size_t ns) override {
+    invalidate(sector, sector + ns - 1);
+    return m_dev->writeSectors(sector, src, ns);
+  }
+  bool writeSectorsPreErase(Sector_t sector, const uint8_t* src, size_t ns,
+                            uint32_t eraseCount) override {
+    // Unwritten sectors in the hinted range may be erased.
+    invalidate(sector, sector + (eraseCount > ns ? eraseCount : ns) - 1);
+    return m_dev->writeSectorsPreErase(sector, src, ns, eraseCount);
+  }
+  bool zeroSectors(Sector_t firstSector, Sector_t lastSector) override {
+    invalidate(firstSector, lastSector);
+    return m_dev->zeroSectors(firstSector, lastSector);
+  }
+
+ private:
+  static const uint16_t NIL = 0XFFFF;
+  uint16_t bucket(Sector_t sector) const {
+    return static_cast<uint32_t>(sector) % m_count;
+  }
+  uint8_t* data(uint16_t i) const { return m_pool + FS_SECTOR_SIZE * i; }
+  uint16_t find(Sector_t sector) const;
+  void hashUnlink(uint16_t i);
+  void insert(Sector_t sector, const uint8_t* src);
+  void invalidate(Sector_t firstSector, Sector_t lastSector);
+  void lruUnlink(uint16_t i);
+  void lruPushBack(uint16_t i);
+  void lruPushFront(uint16_t i);
+
+  FsBlockDeviceInterface* m_dev = nullptr;
+  FsReadCacheSlot* m_slots = nullptr;
+  uint8_t* m_pool = nullptr;
+  uint16_t m_count = 0;
+  uint16_t m_lruHead = NIL;
+  uint16_t m_lruTail = NIL;
+  uint32_t m_hitCount = 0;
+  uint32_t m_missCount = 0;
+};
@@ -0,0 +1,69 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#define DBG_FILE "FsStats.cpp"
+#include "FsStats.h"
+//------------------------------------------------------------------------------
+void FsStats::addDelta(const FsStats& now, const FsStats& start) {
+  cacheHits += now.cacheHits - start.cacheHits;
+  cacheMisses += now.cacheMisses - start.cacheMisses;
+  cacheWrites += now.cacheWrites - start.cacheWrites;
+  deviceReads += now.deviceReads - start.deviceReads;
+  deviceReadSectors += now.deviceReadSectors - start.deviceReadSectors;
+  deviceWrites += now.deviceWrites - start.deviceWrites;
+  deviceWriteSectors += now.deviceWriteSectors - start.deviceWriteSectors;
+  fatGets += now.fatGets - start.fatGets;
+  fatPuts += now.fatPuts - start.fatPuts;
+  bitmapFinds += now.bitmapFinds - start.bitmapFinds;
+  dirScans += now.dirScans - start.dirScans;
+  fileReads += now.fileReads - start.fileReads;
+  fileReadBytes += now.fileReadBytes - start.fileReadBytes;
+  fileWrites += now.fileWrites - start.fileWrites;
+  fileWriteBytes += now.fileWriteBytes - start.fileWriteBytes;
+}
+//------------------------------------------------------------------------------
+static void printCount(print_t* pr, const char* name, uint32_t count) {
+  pr->print(name);
+  pr->write(',');
+  pr->println(count);
+}
+//------------------------------------------------------------------------------
+void FsStats::printStats(print_t* pr) const {
+  printCount(pr, "cacheHits", cacheHits);
+  printCount(pr, "cacheMisses", cacheMisses);
+  printCount(pr, "cacheWrites", cacheWrites);
+  printCount(pr, "deviceReads", deviceReads);
+  printCount(pr, "deviceReadSectors", deviceReadSectors);
+  printCount(pr, "deviceWrites", deviceWrites);
+  printCount(pr, "deviceWriteSectors", deviceWriteSectors);
+  printCount(pr, "fatGets", fatGets);
+  printCount(pr, "fatPuts", fatPuts);
+  printCount(pr, "bitmapFinds", bitmapFinds);
+  printCount(pr, "dirScans", dirScans);
+  printCount(pr, "fileReads", fileReads);
+  printCount(pr, "fileReadBytes", fileReadBytes);
+  printCount(pr, "fileWrites", fileWrites);
+  printCount(pr, "fileWriteBytes", fileWriteBytes);
+  printCount(pr, "deviceCommands", deviceCommands());
+}
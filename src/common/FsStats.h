@@ -0,0 +1,127 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * \file
+ * \brief Filesystem operation counters.
+ */
+#pragma once
+#include <string.h>
+
+#include "SysCall.h"
+/**
+ * \struct FsStats
+ * \brief Counts of filesystem operations and the device commands they cost.
+ *
+ * Sector reads and writes by the caches plus direct reads and writes are
+ * all the commands the filesystem sends to the block device.
+ */
+struct FsStats {
+  /** Sectors found in a cache by prepare(). */
+  uint32_t cacheHits;
+  /** Sectors read into a cache by prepare(). */
+  uint32_t cacheMisses;
+  /** Sectors written by a cache sync(), including FAT mirror writes. */
+  uint32_t cacheWrites;
+  /** Read commands that bypass the cache. */
+  uint32_t deviceReads;
+  /** Sectors read by commands that bypass the cache. */
+  uint32_t deviceReadSectors;
+  /** Write commands that bypass the cache. */
+  uint32_t deviceWrites;
+  /** Sectors written by commands that bypass the cache. */
+  uint32_t deviceWriteSectors;
+  /** FAT entry reads. */
+  uint32_t fatGets;
+  /** FAT entry writes. */
+  uint32_t fatPuts;
+  /** exFAT bitmap searches for free clusters. */
+  uint32_t bitmapFinds;
+  /** Directory searches for a name. */
+  uint32_t dirScans;
+  /** Successful read() calls for regular files. */
+  uint32_t fileReads;
+  /** Bytes returned by read() calls for regular files. */
+  uint32_t fileReadBytes;
+  /** Successful file write() calls. */
+  uint32_t fileWrites;
+  /** Bytes written by file write() calls. */
+  uint32_t fileWriteBytes;
+
+  /** Add the counts that changed between two snapshots.
+   * \param[in] now Current counts.
+   * \param[in] start Counts at the start of the interval.
+   */
+  void addDelta(const FsStats& now, const FsStats& start);
+  /** Set all counts to zero. */
+  void clear() { memset(this, 0, sizeof(FsStats)); }
+  /** \return Number of read and write commands sent to the block device. */
+  uint32_t deviceCommands() const {
+    return cacheMisses + cacheWrites + deviceReads + deviceWrites;
+  }
+  /** Print the counts as name,value lines.
+   * \param[in] pr Print destination.
+   */
+  void printStats(print_t* pr) const;
+};
+#if USE_FS_STATS
+/** Add n to a counter if stats is enabled. */
+#define FS_STATS_ADD(stats, field, n) ((stats)->field += (n))
+#else  // USE_FS_STATS
+#define FS_STATS_ADD(stats, field, n)
+#endif  // USE_FS_STATS
+#if USE_FS_FILE_STATS
+/**
+ * \class FsFileStatsScope
+ * \brief Adds volume counts caused by a file call to the file's counts.
+ */
+class FsFileStatsScope {
+ public:
+  /** Take a snapshot of the volume counts.
+   * \param[in] vol Counts for the volume or nullptr if the file is closed.
+   * \param[in] file Counts for the file.
+   */
+  FsFileStatsScope(const FsStats* vol, FsStats* file)
+      : m_vol(vol), m_file(file) {
+    if (m_vol) {
+      m_start = *m_vol;
+    }
+  }
+  ~FsFileStatsScope() {
+    if (m_vol) {
+      m_file->addDelta(*m_vol, m_start);
+    }
+  }
+
+ private:
+  const FsStats* m_vol;
+  FsStats* m_file;
+  FsStats m_start;
+};
+/** Charge volume counts to the file member m_stats. */
+#define FS_FILE_STATS_SCOPE(vol) \
+  FsFileStatsScope fileStatsScope(vol, &m_stats)
+#else  // USE_FS_FILE_STATS
+#define FS_FILE_STATS_SCOPE(vol)
+#endif  // USE_FS_FILE_STATS
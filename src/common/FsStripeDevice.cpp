@@ -0,0 +1,207 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#define DBG_FILE "FsStripeDevice.cpp"
+#include "FsStripeDevice.h"
+
+#include "DebugMacros.h"
+//------------------------------------------------------------------------------
+uint32_t FsStripeDevice::allocationUnitSectors() {
+  uint32_t au = m_devs[0]->allocationUnitSectors();
+  // A member allocation unit must hold whole stripe units.
+  return au && (au % m_unitSectors) == 0 ? au * m_count : 0;
+}
+//------------------------------------------------------------------------------
+bool FsStripeDevice::begin(FsBlockDeviceInterface** devs, uint8_t count,
+                           uint32_t unitSectors) {
+  Sector_t units = 0;
+  m_count = 0;
+  m_sectorCount = 0;
+  if (count == 0 || count > FS_STRIPE_MAX_DEVICES || unitSectors == 0) {
+    DBG_FAIL_MACRO;
+    return false;
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    Sector_t n = devs[i]->sectorCount() / unitSectors;
+    if (i == 0 || n < units) {
+      units = n;
+    }
+  }
+  if (units == 0) {
+    DBG_FAIL_MACRO;
+    return false;
+  }
+  m_devs = devs;
+  m_count = count;
+  m_unitSectors = unitSectors;
+  m_sectorCount = units * unitSectors * count;
+  return true;
+}
+//------------------------------------------------------------------------------
+bool FsStripeDevice::discardSectors(Sector_t firstSector,
+                                    Sector_t lastSector) {
+  bool rtn = true;
+  for (uint8_t i = 0; i < m_count; i++) {
+    Sector_t first, last;
+    if (memberRange(i, firstSector, lastSector, &first, &last) &&
+        !m_devs[i]->discardSectors(first, last)) {
+      rtn = false;
+    }
+  }
+  return rtn;
+}
+//------------------------------------------------------------------------------
+void FsStripeDevice::end() {
+  for (uint8_t i = 0; i < m_count; i++) {
+    m_devs[i]->end();
+  }
+}
+//------------------------------------------------------------------------------
+bool FsStripeDevice::isBusy() {
+  for (uint8_t i = 0; i < m_count; i++) {
+    if (m_devs[i]->isBusy()) {
+      return true;
+    }
+  }
+  return false;
+}
+//------------------------------------------------------------------------------
+// Map sector to a member, return sectors left in the stripe unit.
+size_t FsStripeDevice::map(Sector_t sector, size_t ns, uint8_t* dev,
+                           Sector_t* devSector) {
+  Sector_t unit = sector / m_unitSectors;
+  uint32_t offset = sector % m_unitSectors;
+  size_t n = m_unitSectors - offset;
+  *dev = unit % m_count;
+  *devSector = (unit / m_count) * m_unitSectors + offset;
+  return n < ns ? n : ns;
+}
+//------------------------------------------------------------------------------
+// Member sectors for a logical range.  A logical range is a single
+// range on each member.  Return false if the member has no sectors.
+bool FsStripeDevice::memberRange(uint8_t dev, Sector_t firstSector,
+                                 Sector_t lastSector, Sector_t* devFirst,
+                                 Sector_t* devLast) {
+  uint8_t tmp;
+  Sector_t unit = firstSector / m_unitSectors;
+  uint8_t skip = (dev + m_count - unit % m_count) % m_count;
+  if (skip) {
+    // First sector of the next unit on dev.
+    firstSector = (unit + skip) * m_unitSectors;
+  }
+  unit = lastSector / m_unitSectors;
+  skip = (unit % m_count + m_count - dev) % m_count;
+  if (skip) {
+    if (unit < skip) {
+      return false;
+    }
+    // Last sector of the previous unit on dev.
+    lastSector = (unit - skip + 1) * m_unitSectors - 1;
+  }
+  if (firstSector > lastSector) {
+    return false;
+  }
+  map(firstSector, 1, &tmp, devFirst);
+  map(lastSector, 1, &tmp, devLast);
+  return true;
+}
+//------------------------------------------------------------------------------
+bool FsStripeDevice::syncDevice() {
+  bool rtn = true;
+  for (uint8_t i = 0; i < m_count; i++) {
+    if (!m_devs[i]->syncDevice()) {
+      rtn = false;
+    }
+  }
+  return rtn;
+}
+//------------------------------------------------------------------------------
+bool FsStripeDevice::transfer(Sector_t sector, uint8_t* buf, size_t ns,
+                              bool write, uint32_t eraseCount) {
+  Sector_t eraseLast = sector + eraseCount - 1;
+  if (ns == 0 || sector >= m_sectorCount || ns > (m_sectorCount - sector)) {
+    DBG_FAIL_MACRO;
+    return false;
+  }
+  while (ns) {
+    // A pass has at most one stripe unit for each member.
+    uint32_t done = 0;
+    Sector_t s = sector;
+    size_t left = ns;
+    uint8_t* p = buf;
+    for (uint8_t pass = 0; pass < 2; pass++) {
+      s = sector;
+      left = ns;
+      p = buf;
+      for (uint8_t k = 0; k < m_count && left; k++) {
+        uint8_t dev;
+        Sector_t devSector;
+        size_t n = map(s, left, &dev, &devSector);
+        FsBlockDeviceInterface* d = m_devs[dev];
+        // Busy members go last in the first pass.
+        if (!(done & (1UL << k)) && (pass || !d->isBusy())) {
+          bool ok;
+          if (!write) {
+            ok = n == 1 ? d->readSector(devSector, p)
+                        : d->readSectors(devSector, p, n);
+          } else if (eraseCount) {
+            Sector_t first, last;
+            uint32_t devErase = 0;
+            if (eraseLast >= s &&
+                memberRange(dev, s, eraseLast, &first, &last)) {
+              devErase = last - first + 1;
+            }
+            ok = d->writeSectorsPreErase(devSector, p, n, devErase);
+          } else {
+            ok = n == 1 ? d->writeSector(devSector, p)
+                        : d->writeSectors(devSector, p, n);
+          }
+          if (!ok) {
+            DBG_FAIL_MACRO;
+            return false;
+          }
+          done |= 1UL << k;
+        }
+        s += n;
+        left -= n;
+        p += FS_SECTOR_SIZE * n;
+      }
+    }
+    sector = s;
+    ns = left;
+    buf = p;
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+bool FsStripeDevice::zeroSectors(Sector_t firstSector, Sector_t lastSector) {
+  for (uint8_t i = 0; i < m_count; i++) {
+    Sector_t first, last;
+    if (memberRange(i, firstSector, lastSector, &first, &last) &&
+        !m_devs[i]->zeroSectors(first, last)) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,107 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+/**
+ * \file
+ * \brief FsStripeDevice class stripes sectors across block devices.
+ */
+#include "SysCall.h"
+// Include order is important.
+#include "FsBlockDeviceInterface.h"
+/** Maximum number of devices in a stripe set. */
+const uint8_t FS_STRIPE_MAX_DEVICES = 32;
+/**
+ * \class FsStripeDevice
+ * \brief RAID-0 block device that stripes sectors across member devices.
+ *
+ * Logical sectors are split into stripe units of unitSectors sectors.
+ * Unit i is on member i % count at member unit i / count.  A transfer
+ * is one multi-sector command per unit, issued in passes with at most
+ * one unit for each member.  Within a pass, members that are not busy
+ * go first so one card can program while the next is written.
+ *
+ * Members on a shared SPI bus must use SHARED_SPI so a card does not
+ * hold the bus between commands.
+ *
+ * Use with USE_BLOCK_DEVICE_INTERFACE nonzero:
+ *
+ * FsBlockDeviceInterface* cards[] = {sd1.card(), sd2.card()};
+ * FsStripeDevice stripe;
+ * ...
+ *   stripe.begin(cards, 2, 64);
+ *   volume.begin(&stripe);
+ */
+class FsStripeDevice : public FsBlockDeviceInterface {
+ public:
+  /** Start using a stripe set.  The members must already be started.
+   *
+   * \param[in] devs Array of member devices.  Must remain valid.
+   * \param[in] count Number of members, at most FS_STRIPE_MAX_DEVICES.
+   * \param[in] unitSectors Stripe unit size in sectors.
+   * \return true for success or false for failure.
+   */
+  bool begin(FsBlockDeviceInterface** devs, uint8_t count,
+             uint32_t unitSectors);
+  /** \return Number of member devices. */
+  uint8_t deviceCount() const { return m_count; }
+  /** \return Stripe unit size in sectors. */
+  uint32_t unitSectors() const { return m_unitSectors; }
+
+  uint32_t allocationUnitSectors() override;
+  bool discardSectors(Sector_t firstSector, Sector_t lastSector) override;
+  void end() override;
+  bool isBusy() override;
+  bool readSector(Sector_t sector, uint8_t* dst) override {
+    return transfer(sector, dst, 1, false, 0);
+  }
+  bool readSectors(Sector_t sector, uint8_t* dst, size_t ns) override {
+    return transfer(sector, dst, ns, false, 0);
+  }
+  Sector_t sectorCount() override { return m_sectorCount; }
+  bool syncDevice() override;
+  bool writeSector(Sector_t sector, const uint8_t* src) override {
+    return transfer(sector, const_cast<uint8_t*>(src), 1, true, 0);
+  }
+  bool writeSectors(Sector_t sector, const uint8_t* src, size_t ns) override {
+    return transfer(sector, const_cast<uint8_t*>(src), ns, true, 0);
+  }
+  bool writeSectorsPreErase(Sector_t sector, const uint8_t* src, size_t ns,
+                            uint32_t eraseCount) override {
+    return transfer(sector, const_cast<uint8_t*>(src), ns, true, eraseCount);
+  }
+  bool zeroSectors(Sector_t firstSector, Sector_t lastSector) override;
+
+ private:
+  size_t map(Sector_t sector, size_t ns, uint8_t* dev, Sector_t* devSector);
+  bool memberRange(uint8_t dev, Sector_t firstSector, Sector_t lastSector,
+                   Sector_t* devFirst, Sector_t* devLast);
+  bool transfer(Sector_t sector, uint8_t* buf, size_t ns, bool write,
+                uint32_t eraseCount);
+
+  FsBlockDeviceInterface** m_devs = nullptr;
+  uint8_t m_count = 0;
+  uint32_t m_unitSectors = 0;
+  Sector_t m_sectorCount = 0;
+};
@@ -0,0 +1,116 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#define DBG_FILE "FsTraceDevice.cpp"
+#include "FsTraceDevice.h"
+
+#include <string.h>
+
+#include "DebugMacros.h"
+//------------------------------------------------------------------------------
+void FsTraceDevice::begin(FsBlockDeviceInterface* dev, FsTraceRecord* ring,
+                          size_t ringSize) {
+  m_dev = dev;
+  m_ring = ring;
+  m_ringSize = ringSize;
+  m_recordCount = 0;
+  m_logErrorCount = 0;
+  m_logDev = nullptr;
+}
+//------------------------------------------------------------------------------
+bool FsTraceDevice::flushLog() {
+  size_t n = m_recordCount % FS_TRACE_PER_SECTOR;
+  if (!m_logDev || n == 0) {
+    return true;
+  }
+  FsTraceRecord buf[FS_TRACE_PER_SECTOR];
+  memcpy(buf, &m_ring[(m_recordCount - n) % m_ringSize],
+         n * sizeof(FsTraceRecord));
+  memset(&buf[n], 0, (FS_TRACE_PER_SECTOR - n) * sizeof(FsTraceRecord));
+  if (!writeLog(buf)) {
+    return false;
+  }
+  // Next sector of records overwrites this partial sector.
+  m_logNext = m_logNext ? m_logNext - 1 : m_logCount - 1;
+  return true;
+}
+//------------------------------------------------------------------------------
+bool FsTraceDevice::getRecord(uint32_t index, FsTraceRecord* record) const {
+  if (index >= m_recordCount || (m_recordCount - index) > m_ringSize) {
+    return false;
+  }
+  *record = m_ring[index % m_ringSize];
+  return true;
+}
+//------------------------------------------------------------------------------
+bool FsTraceDevice::record(uint8_t op, Sector_t sector, size_t ns,
+                           uint32_t start, bool status) {
+  if (m_ringSize) {
+    uint32_t duration = micros() - start;
+    // Split commands with more sectors than count can hold.
+    do {
+      size_t n = ns < 0XFFFF ? ns : 0XFFFF;
+      FsTraceRecord* r = &m_ring[m_recordCount % m_ringSize];
+      r->sector = sector;
+      r->time = start;
+      r->duration = duration;
+      r->count = n;
+      r->op = op;
+      r->status = status;
+      m_recordCount++;
+      if (m_logDev && (m_recordCount % FS_TRACE_PER_SECTOR) == 0) {
+        writeLog(&m_ring[(m_recordCount - FS_TRACE_PER_SECTOR) % m_ringSize]);
+      }
+      sector += n;
+      ns -= n;
+      duration = 0;
+    } while (ns);
+  }
+  return status;
+}
+//------------------------------------------------------------------------------
+bool FsTraceDevice::setLogDevice(FsBlockDeviceInterface* logDev,
+                                 Sector_t firstSector, Sector_t sectorCount) {
+  if (m_ringSize == 0 || (m_ringSize % FS_TRACE_PER_SECTOR) != 0 ||
+      sectorCount == 0) {
+    DBG_FAIL_MACRO;
+    return false;
+  }
+  m_logDev = logDev;
+  m_logFirst = firstSector;
+  m_logCount = sectorCount;
+  m_logNext = 0;
+  return true;
+}
+//------------------------------------------------------------------------------
+bool FsTraceDevice::writeLog(const FsTraceRecord* records) {
+  const uint8_t* src = reinterpret_cast<const uint8_t*>(records);
+  if (!m_logDev->writeSector(m_logFirst + m_logNext, src)) {
+    m_logErrorCount += FS_TRACE_PER_SECTOR;
+    DBG_FAIL_MACRO;
+    return false;
+  }
+  m_logNext = m_logNext + 1 < m_logCount ? m_logNext + 1 : 0;
+  return true;
+}
@@ -0,0 +1,175 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+/**
+ * \file
+ * \brief FsTraceDevice class records block device commands.
+ */
+#include "SysCall.h"
+// Include order is important.
+#include "FsBlockDeviceInterface.h"
+/** Trace record op for unused records. */
+const uint8_t FS_TRACE_NONE = 0;
+/** Trace record op for reads. */
+const uint8_t FS_TRACE_READ = 1;
+/** Trace record op for writes. */
+const uint8_t FS_TRACE_WRITE = 2;
+/** Trace record op for syncDevice(). */
+const uint8_t FS_TRACE_SYNC = 3;
+/**
+ * \struct FsTraceRecord
+ * \brief Sixteen byte trace record, 32 records per 512 bytes.
+ */
+struct FsTraceRecord {
+  /** First sector of the command. */
+  uint32_t sector;
+  /** micros() at the start of the command. */
+  uint32_t time;
+  /** Command duration in microseconds. */
+  uint32_t duration;
+  /** Sector count, zero for sync.  A command of more than 65535 sectors
+   * is split into records with the same time.  Only the first record
+   * has the duration.
+   */
+  uint16_t count;
+  /** FS_TRACE_ op. */
+  uint8_t op;
+  /** One for success or zero for failure. */
+  uint8_t status;
+};
+/** Trace records in a sector. */
+const size_t FS_TRACE_PER_SECTOR = FS_SECTOR_SIZE / sizeof(FsTraceRecord);
+/**
+ * \class FsTraceDevice
+ * \brief Pass through block device that records every command.
+ *
+ * Records go to a ring in RAM.  If a log device is set, each sector of
+ * records is also written to a range of sectors on the log device so a
+ * trace can be longer than the ring.  The log range wraps.
+ *
+ * Use with USE_BLOCK_DEVICE_INTERFACE nonzero:
+ *
+ * FsTraceRecord ring[64];
+ * FsTraceDevice trace;
+ * ...
+ *   trace.begin(&card, ring, 64);
+ *   volume.begin(&trace);
+ */
+class FsTraceDevice : public FsBlockDeviceInterface {
+ public:
+  /** Start tracing a device.
+   *
+   * \param[in] dev Device to be traced.
+   * \param[in] ring Buffer for trace records.
+   * \param[in] ringSize Number of records in ring.  Must be a multiple
+   *            of FS_TRACE_PER_SECTOR with a log device.
+   */
+  void begin(FsBlockDeviceInterface* dev, FsTraceRecord* ring,
+             size_t ringSize);
+  /** Write trace records to a second device.
+   *
+   * \param[in] logDev Device for the trace log.
+   * \param[in] firstSector First sector of the log range.
+   * \param[in] sectorCount Number of sectors in the log range.
+   * \return false if the ring size is not a multiple of
+   *         FS_TRACE_PER_SECTOR.
+   */
+  bool setLogDevice(FsBlockDeviceInterface* logDev, Sector_t firstSector,
+                    Sector_t sectorCount);
+  /** Write the partial sector of records to the log device.
+   * Unused records in the sector have op FS_TRACE_NONE.
+   * \return true for success or false for failure.
+   */
+  bool flushLog();
+  /** Copy a record from the ring.
+   *
+   * \param[in] index Record number, counting from zero at begin().
+   * \param[out] record Copy of the record.
+   * \return false if the record is no longer in the ring.
+   */
+  bool getRecord(uint32_t index, FsTraceRecord* record) const;
+  /** \return Number of records since begin(). */
+  uint32_t recordCount() const { return m_recordCount; }
+  /** \return Number of records not written to the log device. */
+  uint32_t logErrorCount() const { return m_logErrorCount; }
+
+  uint32_t allocationUnitSectors() override {
+    return m_dev->allocationUnitSectors();
+  }
+  bool discardSectors(Sector_t firstSector, Sector_t lastSector) override {
+    return m_dev->discardSectors(firstSector, lastSector);
+  }
+  void end() override { m_dev->end(); }
+  bool isBusy() override { return m_dev->isBusy(); }
+  bool readSector(Sector_t sector, uint8_t* dst) override {
+    uint32_t m = micros();
+    return record(FS_TRACE_READ, sector, 1, m,
+                  m_dev->readSector(sector, dst));
+  }
+  bool readSectors(Sector_t sector, uint8_t* dst, size_t ns) override {
+    uint32_t m = micros();
+    return record(FS_TRACE_READ, sector, ns, m,
+                  m_dev->readSectors(sector, dst, ns));
+  }
+  Sector_t sectorCount() override { return m_dev->sectorCount(); }
+  bool syncDevice() override {
+    uint32_t m = micros();
+    return record(FS_TRACE_SYNC, 0, 0, m, m_dev->syncDevice());
+  }
+  bool writeSector(Sector_t sector, const uint8_t* src) override {
+    uint32_t m = micros();
+    return record(FS_TRACE_WRITE, sector, 1, m,
+                  m_dev->writeSector(sector, src));
+  }
+  bool writeSectors(Sector_t sector, const uint8_t* src, size_t ns) override {
+    uint32_t m = micros();
+    return record(FS_TRACE_WRITE, sector, ns, m,
+                  m_dev->writeSectors(sector, src, ns));
+  }
+  bool writeSectorsPreErase(Sector_t sector, const uint8_t* src, size_t ns,
+                            uint32_t eraseCount) override {
+    uint32_t m = micros();
+    return record(FS_TRACE_WRITE, sector, ns, m,
+                  m_dev->writeSectorsPreErase(sector, src, ns, eraseCount));
+  }
+  bool zeroSectors(Sector_t firstSector, Sector_t lastSector) override {
+    return m_dev->zeroSectors(firstSector, lastSector);
+  }
+
+ private:
+  bool record(uint8_t op, Sector_t sector, size_t ns, uint32_t start,
+              bool status);
+  bool writeLog(const FsTraceRecord* records);
+
+  FsBlockDeviceInterface* m_dev = nullptr;
+  FsBlockDeviceInterface* m_logDev = nullptr;
+  FsTraceRecord* m_ring = nullptr;
+  size_t m_ringSize = 0;
+  uint32_t m_recordCount = 0;
+  uint32_t m_logErrorCount = 0;
+  Sector_t m_logFirst = 0;
+  Sector_t m_logCount = 0;
+  Sector_t m_logNext = 0;
+};
@@ -23,8 +23,27 @@
  * DEALINGS IN THE SOFTWARE.
  */
 #include "FsUtf.h"
+
+#include <string.h>
 namespace FsUtf {
 //----------------------------------------------------------------------------
+size_t asciiLength(const char* str, const char* end) {
+  const char* ptr = str;
+  // Test four characters per step.
+  while ((end - ptr) >= 4) {
+    uint32_t w;
+    memcpy(&w, ptr, 4);
+    if (w & 0X80808080) {
+      break;
+    }
+    ptr += 4;
+  }
+  while (ptr < end && (*ptr & 0X80) == 0) {
+    ptr++;
+  }
+  return ptr - str;
+}
+//----------------------------------------------------------------------------
 char* cpToMb(uint32_t cp, char* str, const char* end) {
   size_t n = end - str;
   if (cp < 0X80) {
@@ -111,4 +130,34 @@ const char* mbToU16(const char* str, const char* end, uint16_t* hs,
   }
   return ptr;
 }
+//----------------------------------------------------------------------------
+size_t u16ToAscii(const uint8_t* u16, size_t n, char* str, const char* end) {
+  size_t i = 0;
+  // Copy four units per step.
+  while ((i + 4) <= n && (end - str) >= static_cast<ptrdiff_t>(i + 4)) {
+    const uint8_t* p = u16 + 2 * i;
+    if (p[1] | p[3] | p[5] | p[7]) {
+      break;
+    }
+    uint32_t w = p[0] | p[2] << 8 | p[4] << 16;
+    w |= static_cast<uint32_t>(p[6]) << 24;
+    // Stop for a zero or non-ASCII byte.
+    if (((w - 0X01010101) | w) & 0X80808080) {
+      break;
+    }
+    str[i] = p[0];
+    str[i + 1] = p[2];
+    str[i + 2] = p[4];
+    str[i + 3] = p[6];
+    i += 4;
+  }
+  for (; i < n && (end - str) > static_cast<ptrdiff_t>(i); i++) {
+    uint8_t c = u16[2 * i];
+    if (u16[2 * i + 1] || c == 0 || c >= 0X80) {
+      break;
+    }
+    str[i] = c;
+  }
+  return i;
+}
 }  // namespace FsUtf
@@ -72,6 +72,12 @@ inline bool isLowSurrogate(uint16_t c) { return 0XDC00 <= c && c <= 0XDFFF; }
 inline uint32_t u16ToCp(uint16_t hs, uint16_t ls) {
   return 0X10000 + (((hs & 0X3FF) << 10) | (ls & 0X3FF));
 }
+/** Find the length of a run of ASCII characters.
+ * \param[in] str location for UTF-8 sequence.
+ * \param[in] end location following last character of str.
+ * \return number of characters before the first non-ASCII character or end.
+ */
+size_t asciiLength(const char* str, const char* end);
 /** Encodes a 32 bit code point as a UTF-8 sequence.
  * \param[in] cp code point to encode.
  * \param[out] str location for UTF-8 sequence.
@@ -96,4 +102,13 @@ const char* mbToCp(const char* str, const char* end, uint32_t* rtn);
  */
 const char* mbToU16(const char* str, const char* end, uint16_t* hs,
                     uint16_t* ls);
+/** Copy a run of ASCII UTF-16 units as characters.
+ * \param[in] u16 location of little endian UTF-16 units.
+ * \param[in] n maximum number of units to copy.
+ * \param[out] str location for characters.
+ * \param[in] end location following last character of str.
+ * \return number of units copied.  Copy stops at a zero unit, a non-ASCII
+ *         unit, or when str is full.
+ */
+size_t u16ToAscii(const uint8_t* u16, size_t n, char* str, const char* end);
 }  // namespace FsUtf
@@ -0,0 +1,172 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#define DBG_FILE "FsWriteCombineDevice.cpp"
+#include "FsWriteCombineDevice.h"
+
+#include <string.h>
+
+#include "DebugMacros.h"
+//------------------------------------------------------------------------------
+bool FsWriteCombineDevice::begin(FsBlockDeviceInterface* dev,
+                                 FsWriteCombineSlot* slots, uint8_t* pool,
+                                 size_t count) {
+  m_dev = dev;
+  m_count = 0;
+  m_pending = 0;
+  if (count > 0XFFFF) {
+    DBG_FAIL_MACRO;
+    return false;
+  }
+  m_slots = slots;
+  m_pool = pool;
+  m_count = count;
+  return true;
+}
+//------------------------------------------------------------------------------
+bool FsWriteCombineDevice::flush() {
+  // Pool order must match sector order for multi-sector writes.
+  sortPool();
+  for (size_t i = 0; i < m_pending;) {
+    size_t n = 1;
+    while ((i + n) < m_pending &&
+           m_slots[i + n].sector == (m_slots[i].sector + n)) {
+      n++;
+    }
+    if (n == 1 ? !m_dev->writeSector(m_slots[i].sector, data(i))
+               : !m_dev->writeSectors(m_slots[i].sector, data(i), n)) {
+      DBG_FAIL_MACRO;
+      return false;
+    }
+    i += n;
+  }
+  m_pending = 0;
+  return true;
+}
+//------------------------------------------------------------------------------
+// Index of the first slot with sector greater than or equal to sector.
+size_t FsWriteCombineDevice::lowerBound(Sector_t sector) const {
+  size_t lo = 0;
+  size_t hi = m_pending;
+  while (lo < hi) {
+    size_t mid = (lo + hi) / 2;
+    if (m_slots[mid].sector < sector) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+//------------------------------------------------------------------------------
+bool FsWriteCombineDevice::readSector(Sector_t sector, uint8_t* dst) {
+  size_t i = lowerBound(sector);
+  if (i < m_pending && m_slots[i].sector == sector) {
+    memcpy(dst, data(m_slots[i].index), FS_SECTOR_SIZE);
+    return true;
+  }
+  return m_dev->readSector(sector, dst);
+}
+//------------------------------------------------------------------------------
+bool FsWriteCombineDevice::readSectors(Sector_t sector, uint8_t* dst,
+                                       size_t ns) {
+  if (!m_dev->readSectors(sector, dst, ns)) {
+    DBG_FAIL_MACRO;
+    return false;
+  }
+  // Replace stale device data with pending data.
+  for (size_t i = lowerBound(sector);
+       i < m_pending && (m_slots[i].sector - sector) < ns; i++) {
+    memcpy(dst + FS_SECTOR_SIZE * (m_slots[i].sector - sector),
+           data(m_slots[i].index), FS_SECTOR_SIZE);
+  }
+  return true;
+}
+//------------------------------------------------------------------------------
+void FsWriteCombineDevice::remove(Sector_t firstSector, Sector_t lastSector) {
+  size_t i = lowerBound(firstSector);
+  while (i < m_pending && m_slots[i].sector <= lastSector) {
+    uint16_t hole = m_slots[i].index;
+    m_pending--;
+    memmove(&m_slots[i], &m_slots[i + 1],
+            (m_pending - i) * sizeof(FsWriteCombineSlot));
+    if (hole != m_pending) {
+      // Keep pool indices in the range [0, m_pending).
+      for (size_t k = 0; k < m_pending; k++) {
+        if (m_slots[k].index == m_pending) {
+          memcpy(data(hole), data(m_pending), FS_SECTOR_SIZE);
+          m_slots[k].index = hole;
+          break;
+        }
+      }
+    }
+  }
+}
+//------------------------------------------------------------------------------
+void FsWriteCombineDevice::sortPool() {
+  uint8_t tmp[FS_SECTOR_SIZE];
+  for (size_t i = 0; i < m_pending; i++) {
+    if (m_slots[i].index == i) {
+      continue;
+    }
+    // Follow the cycle of moves that ends at pool index i.
+    memcpy(tmp, data(i), FS_SECTOR_SIZE);
+    size_t pos = i;
+    while (true) {
+      size_t src = m_slots[pos].index;
+      m_slots[pos].index = pos;
+      if (src == i) {
+        memcpy(data(pos), tmp, FS_SECTOR_SIZE);
+        break;
+      }
+      memcpy(data(pos), data(src), FS_SECTOR_SIZE);
+      pos = src;
+    }
+  }
+}
+//------------------------------------------------------------------------------
+bool FsWriteCombineDevice::writeSector(Sector_t sector, const uint8_t* src) {
+  size_t i = lowerBound(sector);
+  if (i < m_pending && m_slots[i].sector == sector) {
+    memcpy(data(m_slots[i].index), src, FS_SECTOR_SIZE);
+    return true;
+  }
+  if (m_pending == m_count) {
+    if (!flush()) {
+      DBG_FAIL_MACRO;
+      return false;
+    }
+    if (m_count == 0) {
+      return m_dev->writeSector(sector, src);
+    }
+    i = 0;
+  }
+  memmove(&m_slots[i + 1], &m_slots[i],
+          (m_pending - i) * sizeof(FsWriteCombineSlot));
+  m_slots[i].sector = sector;
+  m_slots[i].index = m_pending;
+  memcpy(data(m_pending), src, FS_SECTOR_SIZE);
+  m_pending++;
+  return true;
+}
@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2011-2025 Bill Greiman
+ * This file is part of the SdFat library for SD memory cards.
+ *
+ * MIT License
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ */
+#pragma once
+/**
+ * \file
+ * \brief FsWriteCombineDevice class buffers single sector writes.
+ */
+#include "SysCall.h"
+// Include order is important.
+#include "FsBlockDeviceInterface.h"
+/**
+ * \struct FsWriteCombineSlot
+ * \brief A pending sector write.
+ */
+struct FsWriteCombineSlot {
+  /** Sector to be written. */
+  Sector_t sector;
+  /** Index of the sector data in the pool. */
+  uint16_t index;
+};
+/**
+ * \class FsWriteCombineDevice
+ * \brief Pass through block device that combines single sector writes.
+ *
+ * Single sector writes are held in a pool supplied by the caller.  A
+ * write to a sector that is already pending replaces the pending data.
+ * Pending writes are kept in sector order and written by flush() with
+ * one multi-sector command for each run of adjacent sectors.  flush()
+ * is called by syncDevice(), end() and when the pool is full.
+ *
+ * Reads return pending data.  Multi-sector writes go to the device and
+ * replace pending writes for the same sectors.
+ *
+ * Use with USE_BLOCK_DEVICE_INTERFACE nonzero:
+ *
+ * FsWriteCombineSlot slots[8];
+ * uint8_t pool[8*FS_SECTOR_SIZE];
+ * FsWriteCombineDevice combine;
+ * ...
+ *   combine.begin(&card, slots, pool, 8);
+ *   volume.begin(&combine);
+ */
+class FsWriteCombineDevice : public FsBlockDeviceInterface {
+ public:
+  /** Start buffering writes for a device.
+   *
+   * \param[in] dev Device for the writes.
+   * \param[in] slots Array of count slots.
+   * \param[in] pool Buffer for count sectors.
+   * \param[in] count Number of sectors in the pool, at most 65535.
+   * \return false if count is too large.
+   */
+  bool begin(FsBlockDeviceInterface* dev, FsWriteCombineSlot* slots,
+             uint8_t* pool, size_t count);
+  /** Write all pending sectors to the device.
+   * \return true for success or false for failure.
+   */
+  bool flush();
+  /** \return Number of sectors waiting to be written. */
+  size_t pendingCount() const { return m_pending; }
+
+  uint32_t allocationUnitSectors() override {
+    return m_dev->allocationUnitSectors();
+  }
+  bool discardSectors(Sector_t firstSector, Sector_t lastSector) override {
+    remove(firstSector, lastSector);
+    return m_dev->discardSectors(firstSector, lastSector);
+  }
+  void end() override {
+    flush();
+    m_dev->end();
+  }
+  bool isBusy() override { return m_dev->isBusy(); }
+  bool readSector(Sector_t sector, uint8_t* dst) override;
+  bool readSectors(Sector_t sector, uint8_t* dst, size_t ns) override;
+  Sector_t sectorCount() override { return m_dev->sectorCount(); }
+  bool syncDevice() override { return flush() && m_dev->syncDevice(); }
+  bool writeSector(Sector_t sector, const uint8_t* src) override;
+  bool writeSectors(Sector_t sector, const uint8_t* src, size_t ns) override {
+    if (ns == 1) {
+      return writeSector(sector, src);
+    }
+    remove(sector, sector + ns - 1);
+    return m_dev->writeSectors(sector, src, ns);
+  }
+  bool writeSectorsPreErase(Sector_t sector, const uint8_t* src, size_t ns,
+                            uint32_t eraseCount) override {
+    remove(sector, sector + ns - 1);
+    return m_dev->writeSectorsPreErase(sector, src, ns, eraseCount);
+  }
+  bool zeroSectors(Sector_t firstSector, Sector_t lastSector) override {
+    remove(firstSector, lastSector);
+    return m_dev->zeroSectors(firstSector, lastSector);
+  }
+
+ private:
+  uint8_t* data(size_t index) const { return m_pool + FS_SECTOR_SIZE * index; }
+  size_t lowerBound(Sector_t sector) const;
+  void remove(Sector_t firstSector, Sector_t lastSector);
+  void sortPool();
+
+  FsBlockDeviceInterface* m_dev = nullptr;
+  FsWriteCombineSlot* m_slots = nullptr;
+  uint8_t* m_pool = nullptr;
+  size_t m_count = 0;
+  size_t m_pending = 0;
+};
@@ -57,6 +57,26 @@ typedef Stream stream_t;
 //------------------------------------------------------------------------------
 #else  // ENABLE_ARDUINO_FEATURES
 #include "PrintBasic.h"
+#if defined(__linux__)
+#include <time.h>
+/** \return Milliseconds from the monotonic clock for Linux host builds. */
+inline uint32_t millis() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return 1000UL * ts.tv_sec + ts.tv_nsec / 1000000;
+}
+/** \return Microseconds from the monotonic clock for Linux host builds. */
+inline uint32_t micros() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return 1000000UL * ts.tv_sec + ts.tv_nsec / 1000;
+}
+#else  // defined(__linux__)
+/** \return Milliseconds since startup, must be supplied by the system. */
+uint32_t millis();
+/** \return Microseconds since startup, must be supplied by the system. */
+uint32_t micros();
+#endif  // defined(__linux__)
 /** If not Arduino */
 typedef PrintBasic print_t;
 /** If not Arduino */
@@ -25,6 +25,8 @@
 #include "upcase.h"
 
 #include <stddef.h>
+
+#include "../SdFatConfig.h"
 #ifdef __AVR__
 #include <avr/pgmspace.h>
 #define TABLE_MEM PROGMEM
@@ -36,6 +38,540 @@
 #define readTable16(sym) (sym)
 #endif  // __AVR__
 
+#if USE_UPCASE_PAGE_TABLE
+//------------------------------------------------------------------------------
+// Two-level table generated from the search tables below.  The high byte of
+// a code unit selects a page, zero for no change, and the low byte selects
+// the delta to add in that page.
+static const uint8_t pageIndex[256] TABLE_MEM = {
+    0X01, 0X02, 0X03, 0X04, 0X05, 0X06, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X00, 0X00, 0X07, 0X08, 0X09, 0X00, 0X0A, 0X00, 0X00,
+    0X0B, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X0C, 0X0D, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00, 0X00,
+    0X00, 0X00, 0X00, 0X0E,
+};
+static const uint16_t pageDelta[][256] TABLE_MEM = {
+    // Page 0X00.
+    {
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0,
+        0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0,
+        0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0,
+        0XFFE0, 0XFFE0, 0XFFE0, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0,
+        0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0,
+        0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0X0000,
+        0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0X0079,
+    },
+    // Page 0X01.
+    {
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0X0000, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000,
+        0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000,
+        0XFFFF, 0X0000, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000,
+        0X00C3, 0X0000, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0X0000,
+        0XFFFF, 0X0000, 0X0000, 0X0000, 0XFFFF, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0XFFFF, 0X0000, 0X0000, 0X0061, 0X0000, 0X0000,
+        0X0000, 0XFFFF, 0X00A3, 0X0000, 0X0000, 0X0000, 0X0082, 0X0000,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0X0000,
+        0XFFFF, 0X0000, 0X0000, 0X0000, 0X0000, 0XFFFF, 0X0000, 0X0000,
+        0XFFFF, 0X0000, 0X0000, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000,
+        0X0000, 0XFFFF, 0X0000, 0X0000, 0X0000, 0XFFFF, 0X0000, 0X0038,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0XFFFE, 0X0000,
+        0X0000, 0XFFFE, 0X0000, 0X0000, 0XFFFE, 0X0000, 0XFFFF, 0X0000,
+        0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000,
+        0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0XFFB1, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0X0000, 0X0000, 0XFFFE, 0X0000, 0XFFFF, 0X0000, 0X0000,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+    },
+    // Page 0X02.
+    {
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0X0000, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X2A2B, 0X0000, 0XFFFF, 0X0000, 0X2A28, 0X0000,
+        0X0000, 0X0000, 0XFFFF, 0X0000, 0X0000, 0X0000, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0X0000, 0X0000, 0XFF2E, 0XFF32, 0X0000, 0XFF33, 0XFF33,
+        0X0000, 0XFF36, 0X0000, 0XFF35, 0X0000, 0X0000, 0X0000, 0X0000,
+        0XFF33, 0X0000, 0X0000, 0XFF31, 0X0000, 0X0000, 0X0000, 0X0000,
+        0XFF2F, 0XFF2D, 0X0000, 0X29F7, 0X0000, 0X0000, 0X0000, 0XFF2D,
+        0X0000, 0X0000, 0XFF2B, 0X0000, 0X0000, 0XFF2A, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X29E7, 0X0000, 0X0000,
+        0XFF26, 0X0000, 0X0000, 0XFF26, 0X0000, 0X0000, 0X0000, 0X0000,
+        0XFF26, 0XFFBB, 0XFF27, 0XFF27, 0XFFB9, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0XFF25, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+    },
+    // Page 0X03.
+    {
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0082, 0X0082, 0X0082, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0XFFDA, 0XFFDB, 0XFFDB, 0XFFDB,
+        0X0000, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0,
+        0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0,
+        0XFFE0, 0XFFE0, 0XFFE1, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0,
+        0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFC0, 0XFFC1, 0XFFC1, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0X0000, 0X0007, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0XFFFF, 0X0000, 0X0000, 0XFFFF, 0X0000, 0X0000, 0X0000, 0X0000,
+    },
+    // Page 0X04.
+    {
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0,
+        0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0,
+        0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0,
+        0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0,
+        0XFFB0, 0XFFB0, 0XFFB0, 0XFFB0, 0XFFB0, 0XFFB0, 0XFFB0, 0XFFB0,
+        0XFFB0, 0XFFB0, 0XFFB0, 0XFFB0, 0XFFB0, 0XFFB0, 0XFFB0, 0XFFB0,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000,
+        0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0XFFF1,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+    },
+    // Page 0X05.
+    {
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0,
+        0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0,
+        0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0,
+        0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0,
+        0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+    },
+    // Page 0X1D.
+    {
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0EE6, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+    },
+    // Page 0X1E.
+    {
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+    },
+    // Page 0X1F.
+    {
+        0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0008, 0X0000, 0X0008, 0X0000, 0X0008, 0X0000, 0X0008,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X004A, 0X004A, 0X0056, 0X0056, 0X0056, 0X0056, 0X0064, 0X0064,
+        0X0080, 0X0080, 0X0070, 0X0070, 0X007E, 0X007E, 0X0000, 0X0000,
+        0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008, 0X0008,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0008, 0X0008, 0X0000, 0X0009, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0XFFF7, 0X0000, 0X0000, 0X0000,
+        0X0008, 0X0008, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0008, 0X0008, 0X0000, 0X0000, 0X0000, 0X0007, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0XFFF7, 0X0000, 0X0000, 0X0000,
+    },
+    // Page 0X21.
+    {
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0XFFE4, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0XFFF0, 0XFFF0, 0XFFF0, 0XFFF0, 0XFFF0, 0XFFF0, 0XFFF0, 0XFFF0,
+        0XFFF0, 0XFFF0, 0XFFF0, 0XFFF0, 0XFFF0, 0XFFF0, 0XFFF0, 0XFFF0,
+        0X0000, 0X0000, 0X0000, 0X0000, 0XFFFF, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+    },
+    // Page 0X24.
+    {
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0XFFE6, 0XFFE6, 0XFFE6, 0XFFE6, 0XFFE6, 0XFFE6, 0XFFE6, 0XFFE6,
+        0XFFE6, 0XFFE6, 0XFFE6, 0XFFE6, 0XFFE6, 0XFFE6, 0XFFE6, 0XFFE6,
+        0XFFE6, 0XFFE6, 0XFFE6, 0XFFE6, 0XFFE6, 0XFFE6, 0XFFE6, 0XFFE6,
+        0XFFE6, 0XFFE6, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+    },
+    // Page 0X2C.
+    {
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0,
+        0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0,
+        0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0,
+        0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0,
+        0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0,
+        0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0XFFD0, 0X0000,
+        0X0000, 0XFFFF, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0XFFFF, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0XFFFF,
+        0X0000, 0XFFFF, 0X0000, 0XFFFF, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+    },
+    // Page 0X2D.
+    {
+        0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0,
+        0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0,
+        0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0,
+        0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0,
+        0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0, 0XE3A0, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+    },
+    // Page 0XFF.
+    {
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0,
+        0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0,
+        0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0, 0XFFE0,
+        0XFFE0, 0XFFE0, 0XFFE0, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+        0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000, 0X0000,
+    },
+};
+//------------------------------------------------------------------------------
+uint16_t toUpcase(uint16_t chr) {
+  // Optimize for simple ASCII.
+  if (chr < 127) {
+    return chr - ('a' <= chr && chr <= 'z' ? 'a' - 'A' : 0);
+  }
+  uint8_t page = readTable8(pageIndex[chr >> 8]);
+  if (page == 0) {
+    return chr;
+  }
+  return chr + readTable16(pageDelta[page - 1][chr & 0XFF]);
+}
+#else  // USE_UPCASE_PAGE_TABLE
 struct map16 {
   uint16_t base;
   int8_t off;
@@ -125,6 +661,31 @@ uint16_t toUpcase(uint16_t chr) {
   }
   return chr;
 }
+#endif  // USE_UPCASE_PAGE_TABLE
+//------------------------------------------------------------------------------
+// Upcase four ASCII chars, each less than 0X80, packed in a word.
+static inline uint32_t toUpcaseAscii4(uint32_t w) {
+  // High bit set in bytes with 'a' <= byte <= 'z'.
+  uint32_t lc = (w + 0X1F1F1F1F) & ~(w + 0X05050505) & 0X80808080;
+  return w - (lc >> 2);
+}
+//------------------------------------------------------------------------------
+int8_t cmpUpcaseAscii4(const uint8_t* u16, const char* str) {
+  uint32_t a = 0;
+  uint32_t b = 0;
+  for (uint8_t i = 0; i < 4; i++) {
+    if (u16[2 * i + 1]) {
+      return -1;
+    }
+    a |= static_cast<uint32_t>(u16[2 * i]) << 8 * i;
+    b |= static_cast<uint32_t>(static_cast<uint8_t>(str[i])) << 8 * i;
+  }
+  // Fail for any byte greater than 0X7E.
+  if ((a | b | (a + 0X01010101) | (b + 0X01010101)) & 0X80808080) {
+    return -1;
+  }
+  return toUpcaseAscii4(a) == toUpcaseAscii4(b) ? 1 : 0;
+}
 //------------------------------------------------------------------------------
 uint32_t upcaseChecksum(uint16_t uc, uint32_t sum) {
   sum = (sum << 31) + (sum >> 1) + (uc & 0XFF);
@@ -24,5 +24,14 @@
  */
 #pragma once
 #include <stdint.h>
+/**
+ * Compare four UTF-16 units with four chars ignoring case.
+ *
+ * \param[in] u16 Four little endian UTF-16 units.
+ * \param[in] str Four chars.
+ * \return 1 if equal, 0 if not equal, or -1 if a unit or char is not
+ * in the range 0X00 to 0X7E.
+ */
+int8_t cmpUpcaseAscii4(const uint8_t* u16, const char* str);
 uint16_t toUpcase(uint16_t chr);
 uint32_t upcaseChecksum(uint16_t unicode, uint32_t checksum);